@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Load generator for TrieServer
+// Each connection runs closed-loop: send one request, wait for its response
+// line, record the round-trip time, repeat. Prefixes are taken from the same
+// word file the server loaded (1 to 4 leading characters), with a share of
+// SEARCH requests mixed in. At the end it prints QPS and latency percentiles.
+
+// Open a connection to the server
+// Input: port (TCP on 127.0.0.1) or Unix socket path (used when not empty)
+// Output: socket file descriptor, -1 on failure
+int connectTo(int port, const string &unixPath)
+{
+    int fd;
+
+    if (!unixPath.empty())
+    {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, unixPath.c_str(), sizeof(address.sun_path) - 1);
+        if (connect(fd, (sockaddr *)&address, sizeof(address)) < 0)
+        {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr *)&address, sizeof(address)) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+// Get a latency percentile in microseconds
+// Input: sorted latencies in nanoseconds, percentile in [0, 100]
+// Output: the percentile value in microseconds
+double percentile(const vector<long long> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+
+    size_t index = min(sorted.size() - 1, (size_t)(p / 100.0 * sorted.size()));
+    return sorted[index] / 1000.0;
+}
+
+// Main function
+// Input: word file, optional --port N, --unix PATH, --connections N, --seconds N, --search-percent N
+// Output: integer return code
+// Purpose: Drive the server from several connections and report throughput and latency
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        cerr << "usage: " << argv[0]
+             << " <word-file> [--port N | --unix PATH] [--connections N] [--seconds N] [--search-percent N]" << endl;
+        return 1;
+    }
+
+    int port = 7070;
+    string unixPath = "";
+    int connections = 16;
+    int seconds = 5;
+    int searchPercent = 10;
+
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        string flag = argv[i];
+        if (flag == "--port")
+            port = atoi(argv[i + 1]);
+        else if (flag == "--unix")
+            unixPath = argv[i + 1];
+        else if (flag == "--connections")
+            connections = max(1, atoi(argv[i + 1]));
+        else if (flag == "--seconds")
+            seconds = max(1, atoi(argv[i + 1]));
+        else if (flag == "--search-percent")
+            searchPercent = atoi(argv[i + 1]);
+    }
+
+    vector<string> words;
+    ifstream file(argv[1]);
+    string word;
+    while (getline(file, word))
+    {
+        if (!word.empty() && word.back() == '\r')
+            word.pop_back();
+        if (!word.empty() && word.find(' ') == string::npos)
+            words.push_back(word);
+    }
+    if (words.empty())
+    {
+        cerr << "no words in " << argv[1] << endl;
+        return 1;
+    }
+
+    vector<vector<long long>> latencies(connections);
+    atomic<bool> failed(false);
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(seconds);
+    vector<thread> clients;
+
+    for (int c = 0; c < connections; c++)
+    {
+        clients.emplace_back([&, c]()
+                             {
+                                 int fd = connectTo(port, unixPath);
+                                 if (fd < 0)
+                                 {
+                                     failed = true;
+                                     return;
+                                 }
+
+                                 mt19937 rng(c + 1);
+                                 string response;
+                                 char buffer[65536];
+
+                                 while (chrono::steady_clock::now() < deadline)
+                                 {
+                                     const string &target = words[rng() % words.size()];
+                                     string request;
+                                     if ((int)(rng() % 100) < searchPercent)
+                                         request = "SEARCH " + target + "\n";
+                                     else
+                                         request = "AC " + target.substr(0, 1 + rng() % 4) + " 10\n";
+
+                                     auto start = chrono::steady_clock::now();
+                                     if (write(fd, request.data(), request.size()) != (ssize_t)request.size())
+                                         break;
+
+                                     response.clear();
+                                     while (response.empty() || response.back() != '\n')
+                                     {
+                                         ssize_t got = read(fd, buffer, sizeof(buffer));
+                                         if (got <= 0)
+                                         {
+                                             failed = true;
+                                             close(fd);
+                                             return;
+                                         }
+                                         response.append(buffer, got);
+                                     }
+
+                                     latencies[c].push_back(
+                                         chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+                                 }
+
+                                 close(fd); });
+    }
+
+    for (thread &client : clients)
+    {
+        client.join();
+    }
+
+    if (failed)
+        cerr << "warning: some connections failed" << endl;
+
+    vector<long long> all;
+    for (auto &perConnection : latencies)
+    {
+        all.insert(all.end(), perConnection.begin(), perConnection.end());
+    }
+    sort(all.begin(), all.end());
+
+    cout << "requests:    " << all.size() << " over " << seconds << " s on " << connections << " connections" << endl;
+    cout << "QPS:         " << all.size() / (double)seconds << endl;
+    cout << "p50 latency: " << percentile(all, 50) << " us" << endl;
+    cout << "p99 latency: " << percentile(all, 99) << " us" << endl;
+    cout << "p999 latency: " << percentile(all, 99.9) << " us" << endl;
+
+    return failed ? 1 : 0;
+}
@@ -1,638 +1,88 @@
-#include <iostream>
-#include <vector>
-#include <string>
-#include <algorithm>
-#include <unordered_map>
-#include <stack>
+#include "trie.h"
+#include "trie_ingest.h"
+#include "trie_static.h"
 
-using namespace std;
+#include <fstream>
+#include <unordered_set>
 
-// Each node in the Trie
-class TrieNode
-{
-public:
-    // Each node has up to 26 children (for each letter)
-    TrieNode *children[26];
-    // Each node has a map to store children for extended characters
-    unordered_map<char, TrieNode *> mapchildren;
-
-    // Marks if this node completes a word
-    bool isEndOfWord;
-    int searchFreq;
-    int insertFreq;
-
-    // Constructor
-    TrieNode()
-    {
-        isEndOfWord = false;
-        searchFreq = 0;
-        insertFreq = 0;
-        for (int i = 0; i < 26; i++)
-        {
-            children[i] = nullptr;
-        }
-    }
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
-    bool hasChildren()
-    {
-        for (int i = 0; i < 26; i++)
-        {
-            if (children[i] != nullptr)
-            {
-                return true;
-            }
-        }
-        return !mapchildren.empty();
-    }
-};
-
-// The Trie class
-class Trie
+// Hardware cache-miss counter for the relayout benchmark
+// Input: none
+// Output: file descriptor of the counter, -1 if perf events are not available (always, off Linux)
+int openCacheMissCounter()
 {
-private:
-    TrieNode *root;
-
-    // Helper function to find all words from a node
-    // Input: current node, current word formed so far, results vector to store words
-    // Output: none (modifies results vector by reference)
-    // Purpose: Recursively find all complete words starting from the given node
-    void findAllWords(TrieNode *node, string currentWord, vector<pair<string, int>> &results)
-    {
-        if (!node)
-            return;
-
-        if (node->isEndOfWord)
-        {
-            results.push_back({currentWord, node->searchFreq});
-        }
-
-        for (int i = 0; i < 26; i++)
-        {
-            if (node->children[i] != nullptr)
-            {
-                char nxt = 'a' + i;
-                findAllWords(node->children[i], currentWord + nxt, results);
-            }
-        }
-
-        for (auto &entry : node->mapchildren)
-        {
-            findAllWords(entry.second, (currentWord + entry.first), results);
-        }
-    }
-
-    // Helper function to delete a word from the Trie
-    // Input: current node, word to delete, current depth in the word
-    // Output: boolean indicating whether the current node can be safely deleted
-    // Purpose: Recursively remove the word from the Trie and clean up unused nodes
-    bool deleteHelper(TrieNode *node, const string &word, int depth)
-    {
-        // If the node is a nullptr
-        if (!node)
-        {
-            return false;
-        }
-
-        // Reached the end of the word
-        if (depth == word.size())
-        {
-            if (!node->isEndOfWord)
-                return false; // Word not found
-
-            node->isEndOfWord = false;
-            node->insertFreq--;
-
-            // Node can be deleted if it has no children
-            return !node->hasChildren();
-        }
-        //------------------------------------------------------------------
-
-        char c = word[depth];
-        TrieNode *childNode = nullptr;
-        bool isMapped = false; // Track whether we are using mapchildren
-
-        // Handle standard lowercase characters
-        if (c >= 'a' && c <= 'z')
-        {
-            childNode = node->children[c - 'a'];
-        }
-        else
-        {
-            // Extended characters handled here
-            if (node->mapchildren.count(c))
-            {
-                childNode = node->mapchildren[c];
-                isMapped = true;
-            }
-        }
-
-        // call the function for the child node
-        // true if the child node can be deleted
-        bool shouldDeleteChild = deleteHelper(childNode, word, depth + 1);
-
-        /*
-        if (wordExisted)
-            node->unifreq--;
-        */
-
-        // If child should be deleted, handle the deletion here
-        if (shouldDeleteChild)
-        {
-            delete childNode;
-
-            // Choose the right place to remove from
-            if (isMapped)
-            {
-                node->mapchildren.erase(c);
-            }
-            else
-            {
-                node->children[c - 'a'] = nullptr;
-            }
-        }
-
-        // Parent node can be deleted only if it's not a word AND has no children.
-        return !node->isEndOfWord && !node->hasChildren();
-    }
-
-    // Helper function to count words in the Trie
-    // Input: current node
-    // Output: integer count of words in the subtrie rooted at this node
-    // Purpose: Recursively count all unique words stored in the Trie
-    int countWordsHelper(TrieNode *node)
-    {
-        // 1. If node is null, return 0.
-        // 2. Add 1 if this node marks the end of a word.
-        // 3. Recursively check all 26 children.
-        // 4. Return the total count of words.
-
-        if (!node)
-            return 0;
-
-        int count = node->isEndOfWord; // bool -> 0 or 1
-
-        for (int i = 0; i < 26; i++)
-        {
-            if (node->children[i] != nullptr)
-            {
-                count += countWordsHelper(node->children[i]);
-            }
-        }
-
-        for (auto &entry : node->mapchildren)
-        {
-            count += countWordsHelper(entry.second);
-        }
-
-        return count;
-    }
-
-    // Helper function to find the longest word from a list of words
-    // Input: vector of word-frequency pairs
-    // Output: the longest word (string)
-    // Purpose: Identify the longest word from the provided list, breaking ties lexicographically
-    string LongestPrefixHelper(vector<pair<string, int>> &words)
-    {
-        string best = "";
-
-        for (auto &entry : words)
-        {
-            const string &word = entry.first;
-            if (word.length() > best.length() || (word.length() == best.length() && word < best))
-                best = word;
-        }
-
-        return best;
-    }
-
-public:
-    // Constructor
-    // Input: none
-    // Output: none
-    // Purpose: Initialize the Trie with a root node
-    Trie()
-    {
-        root = new TrieNode();
-    }
-
-    // Insert a word into the Trie
-    // Input: word to insert (string)
-    // Output: none
-    // Purpose: Add a word to the Trie by creating nodes for each character
-    bool insert(string word)
-    {
-        TrieNode *curr = root;
-
-        for (char c : word)
-        {
-            if (c >= 'a' && c <= 'z')
-            {
-                if (curr->children[c - 'a'] == nullptr)
-                {
-                    curr->children[c - 'a'] = new TrieNode();
-                }
-                curr = curr->children[c - 'a'];
-            }
-            else
-            {
-                if (!curr->mapchildren[c])
-                {
-                    curr->mapchildren[c] = new TrieNode();
-                }
-                curr = curr->mapchildren[c];
-            }
-        }
-
-        curr->insertFreq++;
-        if (curr->isEndOfWord)
-        {
-            // Word already existed
-            return false; // duplicate
-        }
-        curr->isEndOfWord = true;
-        return true; // unique
-    }
-
-    // Get the frequency of a word in the Trie
-    // Input: word to check (string)
-    // Output: frequency count (integer)
-    // Purpose: Return how many times the word has been inserted into the Trie
-    int getFrequency(string word)
-    {
-        TrieNode *node = root;
-        for (char c : word)
-        {
-            if (c >= 'a' && c <= 'z')
-            {
-                if (!node->children[c - 'a'])
-                    return 0;
-
-                node = node->children[c - 'a'];
-            }
-            else
-            {
-                if (!node->mapchildren.count(c))
-                    return 0;
-
-                node = node->mapchildren[c];
-            }
-        }
-
-        if (node->isEndOfWord)
-            return node->insertFreq;
-
-        return 0;
-    }
-
-    // Count the total number of unique words in the Trie
-    // Input: none
-    // Output: integer count of unique words
-    // Purpose: Traverse the Trie and count how many unique words are stored
-    int countWords()
-    {
-        // 1. Start counting words from the root node.
-        // 2. Pass the root to the recursive helper.
-
-        return countWordsHelper(root);
-    }
-
-    // Count how many words start with the given prefix
-    // Input: prefix to check (string)
-    // Output: integer count of words with the prefix
-    // Purpose: Find how many complete words begin with the given prefix
-    int prefixCount(const string &prefix)
-    {
-        TrieNode *node = root;
-        vector<pair<string, int>> result;
-
-        for (int i = 0; i < prefix.size(); i++)
-        {
-            int charIndex = prefix[i];
-
-            // To easily modify according to the supported chars.
-            if (charIndex >= 'a' && charIndex <= 'z')
-            {
-                if (!node->children[charIndex - 'a'])
-                    return 0;
-
-                node = node->children[charIndex - 'a'];
-            }
-            else
-            {
-                // Case Sensitive Search
-                if (!node->mapchildren.count(charIndex))
-                    return 0;
-
-                node = node->mapchildren[charIndex];
-            }
-        }
-
-        findAllWords(node, prefix, result);
-
-        return result.size();
-    }
-
-    // Return all words in lexicographical order
-    // Input: none
-    // Output: vector of words in lexicographical order
-    // Purpose: List all words stored in the Trie in sorted order
-    vector<pair<string, int>> Lexicographical()
-    {
-        vector<pair<string, int>> result;
-        TrieNode *node = root;
-        string curr = "";
-
-        findAllWords(node, curr, result);
-
-        return result;
-    }
-
-    // Search for a word in the Trie
-    // Input: word to search for (string)
-    // Output: boolean indicating if the word exists
-    // Purpose: Check if the complete word exists in the Trie
-    bool search(string word)
-    {
-        TrieNode *node = root;
-
-        for (char c : word)
-        {
-            // c = tolower(c);
-            // Case Sensitive Search
-            if (c >= 'a' && c <= 'z')
-            {
-                int index = c - 'a';
-                if (!node->children[index])
-                    return false;
-                node = node->children[index];
-            }
-            else
-            {
-                if (!node->mapchildren.count(c))
-                    return false;
-                node = node->mapchildren[c];
-            }
-        }
-
-        if (node->isEndOfWord)
-        {
-            node->searchFreq++;
-            return true;
-        }
-
-        return false;
-    }
-
-    // Check if any word starts with the given prefix
-    // Input: prefix to check (string)
-    // Output: boolean indicating if any word has this prefix
-    // Purpose: Verify if the prefix exists in the Trie (doesn't need to be a complete word)
-    bool startsWith(string prefix)
-    {
-        TrieNode *current = root;
-
-        for (char c : prefix)
-        {
-            // c = tolower(c);
-            //  Case Sensitive Search
-            if (c >= 'a' && c <= 'z')
-            {
-                int index = c - 'a';
-
-                if (!current->children[index])
-                    return false;
-
-                current = current->children[index];
-            }
-            else
-            {
-                if (!current->mapchildren.count(c))
-                    return false;
-
-                current = current->mapchildren[c];
-            }
-        }
-
-        return true;
-    }
-
-    static bool cmp(const pair<string, int> &a, const pair<string, int> &b)
-    {
-        return a.second > b.second;
-    }
-
-    // Get all words that start with the given prefix
-    // Input: prefix to complete (string)
-    // Output: vector of strings that start with the prefix
-    // Purpose: Find all complete words that begin with the given prefix
-    vector<pair<string, int>> autocomplete(string prefix)
-    {
-        // 1. Create a ptr of type TrieNode and set it to root.
-        // 2. Traverse to get the start node to collect words from.
-        // 3. Check validity of prefix characters and existence in Trie.
-        // 4. Use helper to collect all words from that node & return.
-        // 5. Sort suggestions by frequency (highest first).
-
-        vector<pair<string, int>> suggestions;
-
-        TrieNode *node = root;
-
-        for (int i = 0; i < prefix.size(); i++)
-        {
-            int charIndex = prefix[i];
-
-            // To easily modify according to the supported chars.
-            if ((charIndex >= 'a') && (charIndex <= 'z'))
-            {
-                charIndex = prefix[i] - 'a';
-
-                if (!node->children[charIndex])
-                    return {};
-
-                node = node->children[charIndex];
-            }
-
-            // To handle characters other than lowercase.
-            // Case Insensitive
-            else
-            {
-                // Try mapchildren first
-                if (node->mapchildren.count(charIndex))
-                {
-                    node = node->mapchildren[charIndex];
-                }
-                else
-                {
-                    // Try lowercase children as fallback
-                    int index = tolower(charIndex) - 'a';
-                    if (index < 0 || index >= 26 || !node->children[index])
-                        return {}; // prefix not found
-                    node = node->children[index];
-                }
-            }
-        }
-
-        // Collect all words starting from this node.
-        findAllWords(node, prefix, suggestions);
-
-        // Sort suggestions by frequency (highest first).
-        sort(suggestions.begin(), suggestions.end(), cmp);
-
-        return suggestions;
-    }
-
-    // Find the longest word in the Trie
-    // Input: none
-    // Output: the longest word (string)
-    // Purpose: Traverse the Trie to find the longest word stored
-    string findLongestWord()
-    {
-        string best = "";
-        stack<pair<TrieNode *, string>> st;
-        st.push({root, ""});
-
-        while (!st.empty())
-        {
-            pair<TrieNode *, string> topPair = st.top();
-            TrieNode *node = st.top().first;
-            string curr = st.top().second;
-            st.pop();
-
-            if (node->isEndOfWord)
-            {
-                if (curr.size() > best.size() || (curr.size() == best.size() && curr < best))
-                    best = curr;
-            }
-
-            for (int i = 25; i >= 0; i--)
-            {
-                if (node->children[i])
-                {
-                    char c = 'a' + i;
-                    st.push({node->children[i], curr + c});
-                }
-            }
-
-            // Doesn't guarantee lexicographical order for mapchildren
-            for (auto &entry : node->mapchildren)
-            {
-                st.push({entry.second, curr + entry.first});
-            }
-        }
-
-        return best;
-    }
-
-    // Get the longest word that starts with the given prefix
-    // Input: prefix to match (string)
-    // Output: the longest matching word (string)
-    // Purpose: Find the longest complete word that begins with the given prefix
-    string longestWithPrefix(const string &prefix)
-    {
-        vector<pair<string, int>> words = autocomplete(prefix);
-        string match = LongestPrefixHelper(words);
-
-        return match;
-    }
-
-    // Find the longest prefix of the target that exists in the Trie
-    // Input: target string to match
-    // Output: the longest matching prefix (string)
-    // Purpose: Identify the longest prefix of the target string that is a complete word in the Trie
-    // N.B. This is different from longestWithPrefix which finds words starting with a given prefix.
-    // N.B. This function is used in applications like IP routing.
-    string LongestPrefixMatch(const string &target)
-    {
-        TrieNode *node = root;
-        string currentPrefix = "";
-        string longestPrefix = "";
-
-        for (char c : target)
-        {
-            // Case Sensitive Search
-            if (c >= 'a' && c <= 'z')
-            {
-                if (!node->children[c - 'a'])
-                    break;
-
-                node = node->children[c - 'a'];
-            }
-            else
-            {
-                if (!node->mapchildren.count(c))
-                    break;
-
-                node = node->mapchildren[c];
-            }
-
-            currentPrefix += c;
-
-            if (node->isEndOfWord)
-            {
-                longestPrefix = currentPrefix;
-            }
-        }
-
-        return longestPrefix;
-    }
-
-    // Delete a word from the Trie
-    // Input: word to delete (string)
-    // Output: boolean indicating if deletion was successful
-    // Purpose: Removes the word from the Trie and cleans up unused nodes
-    bool deleteWord(string word)
-    {
-        // Handle empty strings
-        if (word.empty())
-            return false;
-
-        if (!search(word))
-            return false; // no need to call helper
-
-        // Call helper function to handle recursive deletion
-        bool deleteMe = deleteHelper(root, word, 0);
-
-        return deleteMe;
-    }
-
-    // Clear the Trie to free memory
-    // Input: node to clear
-    // Output: void (none)
-    // Purpose: Recursively delete all nodes in the Trie
-    void clear(TrieNode *node)
-    {
-        if (!node)
-            return;
+#ifdef __linux__
+    perf_event_attr attr = {};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
 
-        // Delete all 26 fixed children
-        for (int i = 0; i < 26; i++)
-        {
-            if (node->children[i])
-            {
-                clear(node->children[i]);
-            }
-        }
+// Start or stop a counter opened by openCacheMissCounter
+void enableCounter(int fd, bool enable)
+{
+#ifdef __linux__
+    if (fd >= 0)
+        ioctl(fd, enable ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+#endif
+}
 
-        // Delete all map-based children
-        for (auto &pair : node->mapchildren)
-        {
-            clear(pair.second);
-        }
+// Read and reset a counter opened by openCacheMissCounter
+long long readCounter(int fd)
+{
+    long long value = 0;
+#ifdef __linux__
+    if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value))
+        return -1;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    return value;
+#else
+    return fd < 0 ? -1 : value;
+#endif
+}
 
-        // Delete current node
-        delete node;
-    }
+// Release a counter opened by openCacheMissCounter
+void closeCounter(int fd)
+{
+#ifdef __linux__
+    if (fd >= 0)
+        close(fd);
+#endif
+}
+
+// Keyword set for the compile-time trie test, built by the compiler
+constexpr string_view cppKeywords[] = {
+    "alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char",
+    "class", "const", "constexpr", "const_cast", "continue", "decltype", "default", "delete", "do", "double",
+    "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend",
+    "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not",
+    "nullptr", "operator", "or", "private", "protected", "public", "register", "reinterpret_cast", "return", "short",
+    "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template", "this", "throw",
+    "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void",
+    "volatile", "while"};
+constexpr StaticTrie<staticTrieNodes(cppKeywords)> cppKeywordTrie(cppKeywords);
+
+static_assert(cppKeywordTrie.search("constexpr"), "keyword must be found");
+static_assert(!cppKeywordTrie.search("const_"), "a prefix alone is not a keyword");
+static_assert(cppKeywordTrie.startsWith("reinterpret"), "prefix of a keyword");
+static_assert(!cppKeywordTrie.startsWith("xor"), "no keyword starts with xor");
+static_assert(cppKeywordTrie.LongestPrefixMatch("static_assertion") == "static_assert", "longest keyword prefix");
+static_assert(cppKeywordTrie.LongestPrefixMatch("integer") == "int", "shorter keyword inside a longer word");
 
-    // Destructor
-    // Input: none
-    // Output: none
-    // Purpose: Free all allocated memory when Trie is destroyed
-    ~Trie()
-    {
-        clear(root);
-        root = new TrieNode();
-    }
-};
 
 // Main function
 // Input: none
@@ -741,6 +191,18 @@ int main()
         cout << endl;
     }
 
+    // The bounded top-k walk must rank like the full list cut to k (ties may come out in any order)
+    bool topAgrees = true;
+    for (const string &prefix : testPrefixes)
+    {
+        vector<pair<string, int>> all = trie.autocomplete(prefix);
+        vector<pair<string, int>> top = trie.autocomplete(prefix, 3);
+        topAgrees = top.size() == min<size_t>(3, all.size()) && topAgrees;
+        for (size_t i = 0; i < top.size(); i++)
+            topAgrees = top[i].second == all[i].second && top[i].first.compare(0, prefix.size(), prefix) == 0 && topAgrees;
+    }
+    cout << "Top-3 autocomplete agrees with the sorted full list: " << (topAgrees ? "YES" : "NO") << " (expected: YES)" << endl;
+
     // Test 4: Edge cases
     cout << "\n4. Testing edge cases:" << endl;
     cout << "======================" << endl;
@@ -1018,6 +480,1229 @@ int main()
         cout << "Word count after reinserting 'clean': " << testTrie.countWords() << " (expected: 1)" << endl;
     }
 
+    cout << "\n14. Testing TrieMap key->value storage:" << endl;
+    cout << "========================================" << endl;
+    {
+        TrieMap<int> ages;
+        ages.insert("alice", 31);
+        ages.insert("alina", 27);
+        ages.insert("bob", 45);
+        ages.insert("Bobby", 12);
+        bool unique = ages.insert("alice", 32);
+        cout << "Re-insert 'alice': " << (unique ? "unique" : "updated") << " (expected: updated)" << endl;
+        cout << "Stored keys: " << ages.size() << " (expected: 4)" << endl;
+
+        int *age = ages.find("alice");
+        cout << "Find 'alice': " << (age ? to_string(*age) : "NOT FOUND") << " (expected: 32)" << endl;
+        age = ages.find("ali");
+        cout << "Find 'ali': " << (age ? to_string(*age) : "NOT FOUND") << " (expected: NOT FOUND)" << endl;
+
+        ages.find("alina");
+        ages.find("alina");
+        cout << "Autocomplete for 'al': ";
+        for (auto &entry : ages.autocomplete("al"))
+        {
+            cout << entry.first << "=" << *entry.second << " ";
+        }
+        cout << "(expected: alina=27 alice=32)" << endl;
+
+        bool erased = ages.erase("alice");
+        cout << "Erase 'alice': " << (erased ? "SUCCESS" : "FAILED") << endl;
+        cout << "Find 'alina' after erase: " << (ages.find("alina") ? to_string(*ages.find("alina")) : "NOT FOUND")
+             << " (expected: 27)" << endl;
+
+        int total = 0;
+        for (int value : ages)
+        {
+            total += value;
+        }
+        cout << "Sum of values: " << total << " (expected: 84)" << endl;
+    }
+
+    cout << "\n15. Testing Aho-Corasick scanner:" << endl;
+    cout << "==================================" << endl;
+    {
+        Trie keywords;
+        vector<string> patterns = {"he", "she", "his", "hers"};
+        for (const string &word : patterns)
+        {
+            keywords.insert(word);
+        }
+
+        AhoCorasick scanner(keywords);
+
+        cout << "Matches in 'ushers': ";
+        scanner.scan("ushers", [&](int id, size_t start)
+                     { cout << scanner.pattern(id) << "@" << start << " "; });
+        cout << "(expected: she@1 he@2 hers@2)" << endl;
+
+        // Same text split across two chunks
+        AhoCorasick::ScanState stream;
+        cout << "Matches in 'ush' + 'ers': ";
+        string first = "ush", second = "ers";
+        scanner.scan(first.data(), first.size(), stream, [&](int id, size_t start)
+                     { cout << scanner.pattern(id) << "@" << start << " "; });
+        scanner.scan(second.data(), second.size(), stream, [&](int id, size_t start)
+                     { cout << scanner.pattern(id) << "@" << start << " "; });
+        cout << "(expected: she@1 he@2 hers@2)" << endl;
+
+        // Throughput against calling LongestPrefixMatch at every offset
+        mt19937 rng(42);
+        Trie dictionary;
+        size_t maxLen = 0;
+        for (int i = 0; i < 2000; i++)
+        {
+            string word;
+            int len = 3 + rng() % 6;
+            for (int j = 0; j < len; j++)
+            {
+                word += (char)('a' + rng() % 26);
+            }
+            dictionary.insert(word);
+            maxLen = max(maxLen, word.size());
+        }
+
+        string text(1 << 20, ' ');
+        for (char &c : text)
+        {
+            c = (rng() % 8 == 0) ? ' ' : (char)('a' + rng() % 26);
+        }
+
+        AhoCorasick automaton(dictionary);
+
+        // Pattern texts are spelled back from the parent links of terminal states
+        int badPatterns = 0;
+        for (int id = 0; id < dictionary.countWords(); id++)
+        {
+            badPatterns += !dictionary.search(automaton.pattern(id));
+        }
+        cout << "Pattern texts that are not dictionary words: " << badPatterns << " (expected: 0)" << endl;
+
+        auto startTime = chrono::steady_clock::now();
+        long long acMatches = 0;
+        automaton.scan(text, [&](int, size_t)
+                       { acMatches++; });
+        double acSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+        startTime = chrono::steady_clock::now();
+        long long lpmMatches = 0;
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            if (!dictionary.LongestPrefixMatch(text.substr(i, maxLen)).empty())
+                lpmMatches++;
+        }
+        double lpmSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+        // Independent buffers on several threads share one automaton
+        int threadCount = 4;
+        vector<long long> threadMatches(threadCount, 0);
+        vector<thread> workers;
+        startTime = chrono::steady_clock::now();
+        for (int t = 0; t < threadCount; t++)
+        {
+            workers.emplace_back([&, t]()
+                                 { automaton.scan(text, [&](int, size_t)
+                                                  { threadMatches[t]++; }); });
+        }
+        for (thread &worker : workers)
+        {
+            worker.join();
+        }
+        double mtSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+        double gigabytes = text.size() / 1e9;
+        cout << "Automaton states: " << automaton.stateCount() << endl;
+        cout << "Aho-Corasick:             " << gigabytes / acSeconds << " GB/s (" << acMatches << " matches)" << endl;
+        cout << "LongestPrefixMatch loop:  " << gigabytes / lpmSeconds << " GB/s (" << lpmMatches
+             << " offsets with a match)" << endl;
+        cout << "Aho-Corasick x" << threadCount << " threads: " << threadCount * gigabytes / mtSeconds << " GB/s"
+             << " (per-thread matches equal: " << (threadMatches[threadCount - 1] == acMatches ? "YES" : "NO") << ")"
+             << endl;
+    }
+
+    cout << "\n16. Testing merge, intersect and difference:" << endl;
+    cout << "=============================================" << endl;
+    {
+        vector<string> left = {"apple", "app", "banana", "Zebra", "apple"};
+        vector<string> right = {"apple", "band", "cherry", "Zebra"};
+
+        Trie merged, other;
+        for (const string &word : left)
+            merged.insert(word);
+        for (const string &word : right)
+            other.insert(word);
+        other.search("apple");
+
+        merged.merge(other);
+        cout << "Merged word count: " << merged.countWords() << " (expected: 6)" << endl;
+        cout << "Frequency of 'apple' after merge: " << merged.getFrequency("apple") << " (expected: 3)" << endl;
+        cout << "Words left in merged-from Trie: " << other.countWords() << " (expected: 0)" << endl;
+        cout << "Prefix count '' in merged-from Trie: " << other.prefixCount("") << " (expected: 0)" << endl;
+        cout << "Rank of 'm' in merged-from Trie: " << other.rank("m") << " (expected: 0)" << endl;
+        cout << "Select 0 in merged-from Trie: '" << other.select(0) << "' (expected: '')" << endl;
+        other.insert("kiwi");
+        cout << "Select 0 after reusing it: " << other.select(0) << " (expected: kiwi)" << endl;
+        cout << "Search 'band': " << (merged.search("band") ? "FOUND" : "NOT FOUND") << " (expected: FOUND)" << endl;
+        for (auto &entry : merged.autocomplete("apple"))
+        {
+            cout << "Search frequency of '" << entry.first << "' after merge: " << entry.second << " (expected: 1)" << endl;
+        }
+
+        Trie common, filter;
+        for (const string &word : left)
+            common.insert(word);
+        for (const string &word : right)
+            filter.insert(word);
+
+        common.intersect(filter);
+        cout << "Intersection: ";
+        for (auto &entry : common.Lexicographical())
+            cout << entry.first << " ";
+        cout << "(expected: apple Zebra in any order)" << endl;
+        cout << "Search 'app' after intersect: " << (common.search("app") ? "FOUND" : "NOT FOUND")
+             << " (expected: NOT FOUND)" << endl;
+
+        Trie rest;
+        for (const string &word : left)
+            rest.insert(word);
+
+        rest.difference(filter);
+        cout << "Difference: ";
+        for (auto &entry : rest.Lexicographical())
+            cout << entry.first << " ";
+        cout << "(expected: app banana)" << endl;
+        cout << "Words in the subtracted Trie: " << filter.countWords() << " (expected: 4)" << endl;
+    }
+
+    cout << "\n17. Testing range, rank and select:" << endl;
+    cout << "====================================" << endl;
+    {
+        Trie ordered;
+        vector<string> keys = {"delta", "Alpha", "alpha", "alp", "bravo", "charlie", "9lives", "echo", "{brace}"};
+        for (const string &word : keys)
+            ordered.insert(word);
+
+        cout << "Range ['alp', 'charlie'): ";
+        for (auto &entry : ordered.range("alp", "charlie"))
+            cout << entry.first << " ";
+        cout << "(expected: alp alpha bravo)" << endl;
+
+        cout << "Rank of 'bravo': " << ordered.rank("bravo") << " (expected: 4)" << endl;
+        cout << "Rank of 'b': " << ordered.rank("b") << " (expected: 4)" << endl;
+        cout << "Select 0: " << ordered.select(0) << " (expected: 9lives)" << endl;
+        cout << "Select 8: " << ordered.select(8) << " (expected: {brace})" << endl;
+        cout << "Select 9: '" << ordered.select(9) << "' (expected: '')" << endl;
+
+        // Cross-check against a sorted export on a larger random set
+        mt19937 rng(7);
+        Trie big;
+        for (int i = 0; i < 20000; i++)
+        {
+            string word;
+            int len = 1 + rng() % 8;
+            for (int j = 0; j < len; j++)
+                word += (rng() % 10 == 0) ? (char)('A' + rng() % 26) : (char)('a' + rng() % 26);
+            big.insert(word);
+        }
+        big.deleteWord(big.select(100));
+
+        vector<string> sorted;
+        for (auto &entry : big.Lexicographical())
+            sorted.push_back(entry.first);
+        sort(sorted.begin(), sorted.end());
+
+        bool consistent = true;
+        for (int k = 0; k < (int)sorted.size(); k += 97)
+        {
+            if (big.select(k) != sorted[k] || big.rank(sorted[k]) != k)
+                consistent = false;
+        }
+        cout << "Rank/select agree with sorted export: " << (consistent ? "YES" : "NO") << " (expected: YES)" << endl;
+
+        // Range queries: trie walk against sort-and-scan over the exported vector
+        vector<pair<string, string>> queries;
+        for (int q = 0; q < 20; q++)
+        {
+            string lo = sorted[rng() % sorted.size()];
+            string hi = lo.substr(0, 2) + "~";
+            queries.push_back({lo, hi});
+        }
+
+        auto startTime = chrono::steady_clock::now();
+        long long trieHits = 0;
+        for (auto &query : queries)
+        {
+            big.rangeEach(query.first, query.second, [&](const string &, int)
+                          {
+                              trieHits++;
+                              return true; });
+        }
+        double trieSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+        startTime = chrono::steady_clock::now();
+        long long scanHits = 0;
+        for (auto &query : queries)
+        {
+            vector<pair<string, int>> all = big.Lexicographical();
+            sort(all.begin(), all.end());
+            auto it = lower_bound(all.begin(), all.end(), make_pair(query.first, INT_MIN));
+            for (; it != all.end() && it->first < query.second; ++it)
+                scanHits++;
+        }
+        double scanSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+        cout << "Range hits equal: " << (trieHits == scanHits ? "YES" : "NO") << " (expected: YES)" << endl;
+        cout << "20 range queries, trie walk:     " << trieSeconds * 1000 << " ms" << endl;
+        cout << "20 range queries, sort-and-scan: " << scanSeconds * 1000 << " ms" << endl;
+    }
+
+    cout << "\n18. Testing substring (infix) search:" << endl;
+    cout << "======================================" << endl;
+    {
+        Trie produce;
+        vector<string> items = {"vegetable", "table", "stable", "tablet", "potato", "tab", "Tabasco"};
+        for (const string &word : items)
+            produce.insert(word);
+        produce.search("stable");
+        produce.search("stable");
+        produce.search("tablet");
+
+        produce.enableInfixIndex();
+        cout << "Contains 'tab' (top 3): ";
+        for (auto &entry : produce.contains("tab", 3))
+            cout << entry.first << "--->" << entry.second << " ";
+        cout << "(expected: stable tablet then tab)" << endl;
+
+        produce.insert("notable");
+        produce.deleteWord("table");
+        cout << "Contains 'able' after insert/delete: ";
+        for (auto &entry : produce.contains("able", 10))
+            cout << entry.first << " ";
+        cout << "(expected: stable tablet notable vegetable)" << endl;
+
+        cout << "Contains 'to': ";
+        for (auto &entry : produce.contains("to", 10))
+            cout << entry.first << " ";
+        cout << "(expected: potato)" << endl;
+
+        // Enough deletions to compact the index; the compaction must not see the words being removed
+        for (const char *word : {"vegetable", "stable", "tablet", "notable", "potato"})
+            produce.deleteWord(word);
+        cout << "Contains 'ab' after compaction: ";
+        for (auto &entry : produce.contains("ab", 10))
+            cout << entry.first << " ";
+        cout << "(expected: Tabasco tab)" << endl;
+
+        // Latency and memory against a linear scan of the exported words
+        mt19937 rng(3);
+        Trie indexed, scanned;
+        for (int i = 0; i < 20000; i++)
+        {
+            string word;
+            int len = 4 + rng() % 9;
+            for (int j = 0; j < len; j++)
+                word += (char)('a' + rng() % 26);
+            indexed.insert(word);
+            scanned.insert(word);
+        }
+        indexed.enableInfixIndex();
+
+        vector<string> queries;
+        vector<pair<string, int>> words = indexed.Lexicographical();
+        for (int q = 0; q < 50; q++)
+        {
+            const string &word = words[rng() % words.size()].first;
+            queries.push_back(word.substr(rng() % (word.size() - 3), 3 + rng() % 2));
+        }
+
+        long long hits = 0;
+        auto startTime = chrono::steady_clock::now();
+        for (const string &query : queries)
+            hits += indexed.contains(query, 10).size();
+        double indexSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+        bool same = true;
+        startTime = chrono::steady_clock::now();
+        for (const string &query : queries)
+            same = (scanned.contains(query, 10) == indexed.contains(query, 10)) && same;
+        double scanSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+        cout << "Indexed and scanned results agree: " << (same && hits > 0 ? "YES" : "NO") << " (expected: YES)" << endl;
+        cout << "50 infix queries, trigram index: " << indexSeconds * 1000 << " ms" << endl;
+        cout << "50 infix queries, linear scan:   " << scanSeconds * 1000 << " ms" << endl;
+        cout << "Trigram index size: " << indexed.infixIndexBytes() / 1024 << " KiB for " << words.size() << " words" << endl;
+    }
+
+    cout << "\n19. Testing memory budget with eviction:" << endl;
+    cout << "=========================================" << endl;
+    {
+        // Zipfian query stream over a fixed vocabulary
+        mt19937 rng(11);
+        vector<string> vocabulary;
+        for (int i = 0; i < 20000; i++)
+        {
+            string word;
+            int len = 4 + rng() % 8;
+            for (int j = 0; j < len; j++)
+                word += (char)('a' + rng() % 26);
+            vocabulary.push_back(word);
+        }
+
+        vector<double> cdf;
+        double total = 0;
+        for (size_t rankIndex = 1; rankIndex <= vocabulary.size(); rankIndex++)
+        {
+            total += 1.0 / rankIndex;
+            cdf.push_back(total);
+        }
+
+        size_t budget = 1 << 20;
+        Trie capped;
+        capped.setMemoryBudget(budget, 8, true);
+
+        size_t peak = 0;
+        for (int i = 0; i < 100000; i++)
+        {
+            double draw = uniform_real_distribution<double>(0, total)(rng);
+            const string &word = vocabulary[lower_bound(cdf.begin(), cdf.end(), draw) - cdf.begin()];
+
+            if (!capped.search(word))
+                capped.insert(word);
+            peak = max(peak, capped.memoryUsage());
+        }
+
+        int hotKept = 0;
+        for (int i = 0; i < 20; i++)
+            hotKept += capped.getFrequency(vocabulary[i]) > 0;
+
+        cout << "Budget: " << budget << " bytes, peak footprint: " << peak << " bytes ("
+             << (peak <= budget ? "within budget" : "OVER BUDGET") << ", expected: within budget)" << endl;
+        cout << "Words kept: " << capped.countWords() << " of " << vocabulary.size() << " seen" << endl;
+        cout << "Hottest 20 words still stored: " << hotKept << " (expected: 20)" << endl;
+
+        Trie unlimited;
+        for (const string &word : vocabulary)
+            unlimited.insert(word);
+        cout << "Same vocabulary without a budget: " << unlimited.memoryUsage() << " bytes" << endl;
+
+        // The counters are kept current without a budget too, so this is not a walk per call
+        auto startTime = chrono::steady_clock::now();
+        size_t usageSum = 0;
+        for (int i = 0; i < 100000; i++)
+            usageSum += unlimited.memoryUsage();
+        double usageSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+        cout << "100000 memoryUsage() calls without a budget: " << usageSeconds * 1000 << " ms"
+             << (usageSum ? "" : " (no usage)") << endl;
+
+        // Eviction leaves index compaction to compact(), so no insert rebuilds the infix index
+        Trie indexedCapped;
+        indexedCapped.enableInfixIndex();
+        indexedCapped.setMemoryBudget(budget / 4);
+        vector<double> insertSeconds;
+        for (const string &word : vocabulary)
+        {
+            startTime = chrono::steady_clock::now();
+            indexedCapped.insert(word);
+            insertSeconds.push_back(chrono::duration<double>(chrono::steady_clock::now() - startTime).count());
+        }
+        sort(insertSeconds.begin(), insertSeconds.end());
+        size_t indexBefore = indexedCapped.infixIndexBytes();
+        indexedCapped.compact();
+        cout << "99.9th percentile insert with an infix index under budget: "
+             << insertSeconds[insertSeconds.size() * 999 / 1000] * 1e6 << " us" << endl;
+        cout << "compact() shrinks the infix index: " << (indexedCapped.infixIndexBytes() < indexBefore ? "YES" : "NO")
+             << " (expected: YES)" << endl;
+    }
+
+    cout << "\n20. Testing negative-lookup filter:" << endl;
+    cout << "====================================" << endl;
+    {
+        mt19937 rng(5);
+        vector<string> stored;
+        Trie plain, filtered;
+        filtered.enableNegativeFilter(0.01);
+        for (int i = 0; i < 30000; i++)
+        {
+            string word;
+            int len = 6 + rng() % 8;
+            for (int j = 0; j < len; j++)
+                word += (char)('a' + rng() % 26);
+            stored.push_back(word);
+            plain.insert(word);
+            filtered.insert(word);
+        }
+
+        bool allFound = true;
+        for (const string &word : stored)
+            allFound = filtered.search(word) && allFound;
+        cout << "All stored words found through the filter: " << (allFound ? "YES" : "NO") << " (expected: YES)" << endl;
+
+        filtered.deleteWord(stored[0]);
+        cout << "Search deleted word: " << (filtered.search(stored[0]) ? "FOUND" : "NOT FOUND")
+             << " (expected: NOT FOUND)" << endl;
+        filtered.insert(stored[0]);
+        cout << "Search re-inserted word: " << (filtered.search(stored[0]) ? "FOUND" : "NOT FOUND")
+             << " (expected: FOUND)" << endl;
+
+        // Misses share all but their last character with a stored word, so the Trie descends deep
+        vector<string> misses;
+        while (misses.size() < 30000)
+        {
+            string word = stored[rng() % stored.size()];
+            word.back() = (char)('A' + rng() % 26);
+            misses.push_back(word);
+        }
+
+        int falsePositives = 0;
+        BloomFilter probe(stored.size(), 0.01);
+        for (const string &word : stored)
+            probe.add(word);
+        for (const string &word : misses)
+            falsePositives += probe.mayContain(word);
+        cout << "Measured false-positive rate: " << 100.0 * falsePositives / misses.size() << "% (target: 1%)" << endl;
+        cout << "Filter size: " << filtered.negativeFilterBytes() / 1024 << " KiB for " << stored.size() << " words" << endl;
+
+        vector<int> missPercents = {50, 75, 90, 99};
+        for (int missPercent : missPercents)
+        {
+            vector<string> queries;
+            for (int i = 0; i < 100000; i++)
+                queries.push_back((int)(rng() % 100) < missPercent ? misses[rng() % misses.size()]
+                                                                   : stored[rng() % stored.size()]);
+
+            auto startTime = chrono::steady_clock::now();
+            int hits = 0;
+            for (const string &query : queries)
+                hits += plain.search(query);
+            double plainSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+            startTime = chrono::steady_clock::now();
+            int filteredHits = 0;
+            for (const string &query : queries)
+                filteredHits += filtered.search(query);
+            double filteredSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+            cout << missPercent << "% misses: plain " << plainSeconds * 1e9 / queries.size() << " ns/lookup, filtered "
+                 << filteredSeconds * 1e9 / queries.size() << " ns/lookup"
+                 << (hits == filteredHits ? "" : " (RESULTS DIFFER)") << endl;
+        }
+    }
+
+    cout << "\n21. Testing parallel corpus ingestion:" << endl;
+    cout << "=======================================" << endl;
+    {
+        string textPath = "trie_ingest_demo.txt";
+        string csvPath = "trie_ingest_demo.csv";
+        {
+            ofstream text(textPath);
+            text << "the quick brown fox\njumps over the lazy dog\n  the end\n";
+            ofstream csv(csvPath);
+            csv << "id,name,country\n1,alice,\"Cairo, Egypt\"\n2,bob,Giza\n3,\"carol\",Cairo\n";
+        }
+
+        Trie words;
+        WhitespaceTokenizer whitespace;
+        IngestStats stats = CorpusIngestor::ingest(words, {textPath}, whitespace, 2, 8);
+        cout << "Whitespace tokens: " << stats.words << " (expected: 11)" << endl;
+        cout << "Frequency of 'the': " << words.getFrequency("the") << " (expected: 3)" << endl;
+
+        Trie lines;
+        LineTokenizer lineTokenizer;
+        CorpusIngestor::ingest(lines, {textPath}, lineTokenizer);
+        cout << "Search line 'jumps over the lazy dog': "
+             << (lines.search("jumps over the lazy dog") ? "FOUND" : "NOT FOUND") << " (expected: FOUND)" << endl;
+
+        Trie countries;
+        CsvColumnTokenizer thirdColumn(2);
+        CorpusIngestor::ingest(countries, {csvPath}, thirdColumn);
+        cout << "CSV column 'country': ";
+        for (auto &entry : countries.range("", "~"))
+            cout << "[" << entry.first << "] x" << countries.getFrequency(entry.first) << " ";
+        cout << "(expected: [Cairo] x1 [Cairo, Egypt] x1 [Giza] x1 [country] x1)" << endl;
+
+        // Quoted fields with newlines, in a file cut into many small chunks
+        {
+            ofstream csv(csvPath);
+            for (int i = 0; i < 2000; i++)
+                csv << i << ",\"multi\nline, " << i << "\nnote\",tag" << i << "\n";
+        }
+        Trie tags;
+        stats = CorpusIngestor::ingest(tags, {csvPath}, thirdColumn, 4, 4096);
+        bool tagsOnly = true;
+        for (auto &entry : tags.Lexicographical())
+            tagsOnly = entry.first.compare(0, 3, "tag") == 0 && tagsOnly;
+        cout << "CSV records with quoted newlines: " << stats.words << ", all from the tag column: "
+             << (tagsOnly ? "YES" : "NO") << " (expected: 2000, YES)" << endl;
+
+        // Throughput on a generated corpus
+        mt19937 rng(21);
+        vector<string> vocabulary;
+        for (int i = 0; i < 5000; i++)
+        {
+            string word;
+            int len = 3 + rng() % 8;
+            for (int j = 0; j < len; j++)
+                word += (char)('a' + rng() % 26);
+            vocabulary.push_back(word);
+        }
+        {
+            ofstream text(textPath);
+            string line;
+            for (int i = 0; i < 1000000; i++)
+            {
+                line += vocabulary[rng() % vocabulary.size()];
+                line += (i % 12 == 11) ? '\n' : ' ';
+                if (line.size() > 65536)
+                {
+                    text << line;
+                    line.clear();
+                }
+            }
+            text << line;
+        }
+
+        Trie corpus;
+        stats = CorpusIngestor::ingest(corpus, {textPath}, whitespace, 4, 1 << 20);
+        long long totalFrequency = 0;
+        for (auto &entry : corpus.Lexicographical())
+            totalFrequency += corpus.getFrequency(entry.first);
+
+        cout << "Ingested " << stats.bytes / (1 << 20) << " MiB, " << stats.words << " words in " << stats.seconds
+             << " s (" << stats.bytes / 1e9 / stats.seconds * 60 << " GB/min)" << endl;
+        cout << "Summed insertFreq equals word count: " << (totalFrequency == (long long)stats.words ? "YES" : "NO")
+             << " (expected: YES)" << endl;
+
+        remove(textPath.c_str());
+        remove(csvPath.c_str());
+    }
+
+    cout << "\n22. Testing cache-conscious relayout (optimize):" << endl;
+    cout << "=================================================" << endl;
+    {
+        mt19937 rng(22);
+        vector<string> vocabulary;
+        for (int i = 0; i < 60000; i++)
+        {
+            string word;
+            int len = 5 + rng() % 10;
+            for (int j = 0; j < len; j++)
+                word += (char)('a' + rng() % 26);
+            vocabulary.push_back(word);
+        }
+
+        // Interleave unrelated allocations so the nodes end up scattered, as after a long bulk load
+        Trie relaid;
+        vector<string *> noise;
+        for (const string &word : vocabulary)
+        {
+            relaid.insert(word);
+            noise.push_back(new string(100 + rng() % 400, 'x'));
+        }
+        for (string *block : noise)
+            delete block;
+
+        // Skewed lookups: a small set of words gets most of the searches
+        vector<string> queries;
+        for (int i = 0; i < 300000; i++)
+            queries.push_back(vocabulary[(rng() % 10 < 8) ? rng() % 2000 : rng() % vocabulary.size()]);
+
+        int counter = openCacheMissCounter();
+        // Full-subtree walks (every word under each letter) and point lookups, best of two runs
+        auto timeWalks = [&](long long &misses)
+        {
+            double best = 1e9;
+            for (int run = 0; run < 2; run++)
+            {
+                readCounter(counter);
+                enableCounter(counter, true);
+                auto startTime = chrono::steady_clock::now();
+                for (char c = 'a'; c <= 'z'; c++)
+                    relaid.autocomplete(string(1, c));
+                relaid.countWords();
+                best = min(best, chrono::duration<double>(chrono::steady_clock::now() - startTime).count());
+                enableCounter(counter, false);
+                misses = readCounter(counter);
+            }
+            return best;
+        };
+        auto timeLookups = [&](long long &misses)
+        {
+            double best = 1e9;
+            int hits = 0;
+            for (int run = 0; run < 2; run++)
+            {
+                hits = 0;
+                readCounter(counter);
+                enableCounter(counter, true);
+                auto startTime = chrono::steady_clock::now();
+                for (const string &query : queries)
+                    hits += relaid.search(query);
+                best = min(best, chrono::duration<double>(chrono::steady_clock::now() - startTime).count());
+                enableCounter(counter, false);
+                misses = readCounter(counter);
+            }
+            return make_pair(hits, best);
+        };
+
+        // Scattered, then hot-first (the scattered lookups give the hot words their searchFreq), then key order
+        long long walkMisses[3], lookupMisses[3];
+        double walks[3];
+        pair<int, double> lookups[3];
+        int words[3];
+        for (int layout = 0; layout < 3; layout++)
+        {
+            if (layout > 0)
+                relaid.optimize(layout == 1);
+            walks[layout] = timeWalks(walkMisses[layout]);
+            lookups[layout] = timeLookups(lookupMisses[layout]);
+            words[layout] = relaid.countWords();
+        }
+
+        cout << "Words scattered/hot-first/key order: " << words[0] << " / " << words[1] << " / " << words[2]
+             << " (expected: equal)" << endl;
+        cout << "Lookup hits scattered/hot-first/key order: " << lookups[0].first << " / " << lookups[1].first << " / "
+             << lookups[2].first << " (expected: equal)" << endl;
+        cout << "Full-subtree walks scattered: " << walks[0] * 1000 << " ms, hot-first: " << walks[1] * 1000
+             << " ms, key order: " << walks[2] * 1000 << " ms" << endl;
+        cout << "Lookup latency scattered: " << lookups[0].second * 1e9 / queries.size()
+             << " ns, hot-first: " << lookups[1].second * 1e9 / queries.size()
+             << " ns, key order: " << lookups[2].second * 1e9 / queries.size() << " ns" << endl;
+        if (walkMisses[0] >= 0)
+        {
+            cout << "Cache misses during the walks scattered: " << walkMisses[0] << ", hot-first: " << walkMisses[1]
+                 << ", key order: " << walkMisses[2] << endl;
+            cout << "Cache misses during the lookups scattered: " << lookupMisses[0] << ", hot-first: "
+                 << lookupMisses[1] << ", key order: " << lookupMisses[2] << endl;
+        }
+        else
+        {
+            cout << "Cache misses: n/a (perf events not available)" << endl;
+        }
+
+        // Slots freed inside the arena still count against the footprint until insert reuses them
+        size_t footprint = relaid.memoryUsage();
+        for (int i = 1; i <= 1000; i++)
+            relaid.deleteWord(vocabulary[i]);
+        size_t afterDeletes = relaid.memoryUsage();
+        for (int i = 1; i <= 1000; i++)
+            relaid.insert(vocabulary[i]);
+        cout << "Footprint after deleting 1000 words: " << (afterDeletes == footprint ? "unchanged" : "CHANGED")
+             << ", after inserting them again: " << (relaid.memoryUsage() == footprint ? "unchanged" : "CHANGED")
+             << " (expected: unchanged, unchanged)" << endl;
+
+        // The relaid Trie keeps supporting updates
+        relaid.insert("zzzrelaid");
+        relaid.deleteWord(vocabulary[0]);
+        cout << "Insert after optimize: " << (relaid.search("zzzrelaid") ? "FOUND" : "NOT FOUND") << " (expected: FOUND)"
+             << endl;
+        cout << "Delete after optimize: " << (relaid.search(vocabulary[0]) ? "FOUND" : "NOT FOUND")
+             << " (expected: NOT FOUND)" << endl;
+        cout << "Autocomplete 'zzz' after optimize: " << relaid.autocomplete("zzz").size() << " (expected: at least 1)"
+             << endl;
+
+        closeCounter(counter);
+    }
+
+    cout << "\n23. Testing root jump table:" << endl;
+    cout << "=============================" << endl;
+    {
+        // Short keys over a mixed alphabet, so the first levels include mapchildren lookups
+        const string alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJ0123456789-_";
+        mt19937 rng(23);
+        auto randomKey = [&](int maxLength)
+        {
+            string key;
+            int len = 1 + rng() % maxLength;
+            for (int j = 0; j < len; j++)
+                key += alphabet[rng() % alphabet.size()];
+            return key;
+        };
+
+        Trie plain, jumped;
+        for (int i = 0; i < 40000; i++)
+        {
+            string key = randomKey(4);
+            plain.insert(key);
+            jumped.insert(key);
+        }
+        jumped.enableJumpTable(2);
+
+        vector<string> queries;
+        for (int i = 0; i < 200000; i++)
+            queries.push_back(randomKey(5));
+
+        // Keep changing both tries so the table is checked against inserts and deletes too
+        int mismatches = 0;
+        for (int i = 0; i < 20000; i++)
+        {
+            const string &query = queries[i];
+            if (i % 4 == 0)
+            {
+                plain.insert(query);
+                jumped.insert(query);
+            }
+            else if (i % 4 == 1)
+            {
+                plain.deleteWord(query);
+                jumped.deleteWord(query);
+            }
+
+            mismatches += plain.search(query) != jumped.search(query);
+            mismatches += plain.startsWith(query) != jumped.startsWith(query);
+            mismatches += plain.prefixCount(query) != jumped.prefixCount(query);
+            mismatches += plain.LongestPrefixMatch(query) != jumped.LongestPrefixMatch(query);
+            mismatches += plain.autocomplete(query.substr(0, 2)).size() != jumped.autocomplete(query.substr(0, 2)).size();
+        }
+        cout << "Results differing from the plain walk: " << mismatches << " (expected: 0)" << endl;
+
+        // Bulk changes rebuild the table
+        Trie extra;
+        extra.insert("Zq9");
+        jumped.merge(extra);
+        cout << "Search 'Zq9' after merge: " << (jumped.search("Zq9") ? "FOUND" : "NOT FOUND") << " (expected: FOUND)"
+             << endl;
+        jumped.optimize();
+        cout << "Prefix count 'Zq' after optimize: " << jumped.prefixCount("Zq") << " (expected: at least 1)" << endl;
+        plain.insert("Zq9");
+
+        auto timeQueries = [&](Trie &trie)
+        {
+            auto startTime = chrono::steady_clock::now();
+            long long total = 0;
+            for (const string &query : queries)
+            {
+                total += trie.startsWith(query);
+                total += trie.prefixCount(query);
+                total += trie.LongestPrefixMatch(query).size();
+            }
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+            return make_pair(total, seconds);
+        };
+
+        auto slow = timeQueries(plain);
+        auto fast = timeQueries(jumped);
+        cout << "Same answers on the benchmark queries: " << (slow.first == fast.first ? "YES" : "NO")
+             << " (expected: YES)" << endl;
+        cout << "Short-key queries without table: " << slow.second * 1e9 / queries.size() << " ns, with 2-level table: "
+             << fast.second * 1e9 / queries.size() << " ns (" << jumped.jumpTableBytes() / 1024 << " KiB)" << endl;
+    }
+
+    cout << "\n24. Testing incremental typing session:" << endl;
+    cout << "========================================" << endl;
+    {
+        Trie typing;
+        for (string word : {"app", "apple", "application", "apply", "apt", "banana"})
+            typing.insert(word);
+        for (int i = 0; i < 3; i++)
+            typing.search("apply");
+        typing.search("application");
+
+        TrieSession session(typing);
+        for (char c : string("app"))
+            session.push(c);
+        auto top = session.suggestions(2);
+        cout << "Top 2 for 'app': ";
+        for (auto &entry : top)
+            cout << entry.first << " ";
+        cout << "(expected: apply application)" << endl;
+
+        session.push('x');
+        cout << "Matches for 'appx': " << (session.hasMatches() ? "YES" : "NO") << " (expected: NO)" << endl;
+        session.pop();
+        session.push('l');
+        cout << "Suggestions for 'appl': " << session.suggestions(10).size() << " (expected: 3)" << endl;
+
+        // Changes to the Trie are picked up by the next call
+        typing.insert("applaud");
+        cout << "After inserting 'applaud': " << session.suggestions(10).size() << " (expected: 4)" << endl;
+        for (string word : {"apple", "application", "apply", "applaud"})
+            typing.deleteWord(word);
+        cout << "After deleting every 'appl' word: " << session.suggestions(10).size() << " (expected: 0)" << endl;
+        session.pop();
+        cout << "Back at 'app': " << session.suggestions(10).size() << " (expected: 1)" << endl;
+    }
+    {
+        // Typing benchmark: users type target words with occasional typos fixed by backspace
+        mt19937 rng(24);
+        vector<string> vocabulary;
+        for (int i = 0; i < 100000; i++)
+        {
+            string word;
+            int len = 4 + rng() % 9;
+            for (int j = 0; j < len; j++)
+                word += (char)('a' + (j == 0 ? rng() % 26 : (rng() % 3 ? rng() % 8 : rng() % 26)));
+            vocabulary.push_back(word);
+        }
+
+        Trie typing;
+        for (const string &word : vocabulary)
+            typing.insert(word);
+        for (int i = 0; i < 50000; i++)
+            typing.search(vocabulary[(size_t)(vocabulary.size() * pow((rng() % 1000 + 1) / 1000.0, 3)) % vocabulary.size()]);
+
+        // A keystroke is a character or a backspace (-1)
+        vector<vector<int>> sessions;
+        for (int i = 0; i < 300; i++)
+        {
+            const string &target = vocabulary[rng() % vocabulary.size()];
+            vector<int> keys;
+            for (char c : target)
+            {
+                // Typos are fixed right away, and never empty the input box
+                if (!keys.empty() && rng() % 10 == 0)
+                {
+                    keys.push_back('a' + rng() % 26);
+                    keys.push_back(-1);
+                }
+                keys.push_back(c);
+            }
+            sessions.push_back(keys);
+        }
+
+        // The first keystroke has to look at a whole first-level subtree either way,
+        // so it is timed apart from the keystrokes that follow it
+        int keystrokes = 0;
+        int mismatches = 0;
+        double sessionFirst = 0, sessionRest = 0;
+        vector<vector<pair<string, int>>> fromSession;
+        for (auto &keys : sessions)
+        {
+            TrieSession session(typing);
+            for (size_t i = 0; i < keys.size(); i++)
+            {
+                auto startTime = chrono::steady_clock::now();
+                if (keys[i] < 0)
+                    session.pop();
+                else
+                    session.push((char)keys[i]);
+                fromSession.push_back(session.suggestions(10));
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+                (i == 0 ? sessionFirst : sessionRest) += seconds;
+                keystrokes++;
+            }
+        }
+
+        double autocompleteFirst = 0, autocompleteRest = 0;
+        size_t next = 0;
+        for (auto &keys : sessions)
+        {
+            string prefix;
+            for (size_t i = 0; i < keys.size(); i++)
+            {
+                auto startTime = chrono::steady_clock::now();
+                if (keys[i] < 0)
+                    prefix.pop_back();
+                else
+                    prefix += (char)keys[i];
+                auto all = typing.autocomplete(prefix);
+                all.resize(min<size_t>(all.size(), 10));
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+                (i == 0 ? autocompleteFirst : autocompleteRest) += seconds;
+
+                // autocomplete does not order ties, so compare the frequencies only
+                for (size_t i = 0; i < all.size(); i++)
+                    mismatches += i >= fromSession[next].size() || all[i].second != fromSession[next][i].second;
+                mismatches += all.size() != fromSession[next].size();
+                next++;
+            }
+        }
+
+        int later = keystrokes - sessions.size();
+        cout << "Keystrokes simulated: " << keystrokes << ", ranking mismatches: " << mismatches << " (expected: 0)"
+             << endl;
+        cout << "First keystroke, autocomplete(prefix): " << autocompleteFirst * 1e6 / sessions.size()
+             << " us, session: " << sessionFirst * 1e6 / sessions.size() << " us" << endl;
+        cout << "Later keystrokes, autocomplete(prefix): " << autocompleteRest * 1e6 / later
+             << " us, session: " << sessionRest * 1e6 / later << " us" << endl;
+    }
+
+    cout << "\n25. Testing compile-time keyword trie:" << endl;
+    cout << "=======================================" << endl;
+    {
+        // The table was built and checked (static_assert above) by the compiler
+        cout << "Nodes: " << cppKeywordTrie.nodeCount() << ", table size: " << sizeof(cppKeywordTrie) << " bytes" << endl;
+
+        Trie runtimeTrie;
+        unordered_set<string> keywordSet;
+        for (string_view keyword : cppKeywords)
+        {
+            runtimeTrie.insert(string(keyword));
+            keywordSet.insert(string(keyword));
+        }
+
+        // Tokens from source code: keywords, identifiers that share prefixes with them, and others
+        mt19937 rng(25);
+        vector<string> fillers = {"value", "index", "count", "std", "vector", "integer", "classic", "newest", "format",
+                                  "static_data", "do_work", "x", "tmp", "result", "unsigned_int", "try_lock"};
+        vector<string> tokens;
+        for (int i = 0; i < 400000; i++)
+        {
+            if (rng() % 2)
+                tokens.push_back(string(cppKeywords[rng() % size(cppKeywords)]));
+            else
+                tokens.push_back(fillers[rng() % fillers.size()]);
+        }
+
+        int mismatches = 0;
+        for (int i = 0; i < 20000; i++)
+        {
+            const string &token = tokens[i];
+            bool expected = keywordSet.count(token);
+            mismatches += cppKeywordTrie.search(token) != expected;
+            mismatches += cppKeywordTrie.startsWith(token) != runtimeTrie.startsWith(token);
+            mismatches += string(cppKeywordTrie.LongestPrefixMatch(token)) != runtimeTrie.LongestPrefixMatch(token);
+        }
+        cout << "Results differing from Trie / unordered_set: " << mismatches << " (expected: 0)" << endl;
+
+        auto timeLookups = [&](auto lookup)
+        {
+            auto startTime = chrono::steady_clock::now();
+            int hits = 0;
+            for (const string &token : tokens)
+                hits += lookup(token);
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+            return make_pair(hits, seconds * 1e9 / tokens.size());
+        };
+
+        auto staticResult = timeLookups([&](const string &token)
+                                        { return cppKeywordTrie.search(token); });
+        auto trieResult = timeLookups([&](const string &token)
+                                      { return runtimeTrie.search(token); });
+        auto setResult = timeLookups([&](const string &token)
+                                     { return keywordSet.count(token) > 0; });
+
+        cout << "Hits: " << staticResult.first << " / " << trieResult.first << " / " << setResult.first
+             << " (expected: all equal)" << endl;
+        cout << "Keyword lookup: StaticTrie " << staticResult.second << " ns, Trie " << trieResult.second
+             << " ns, unordered_set " << setResult.second << " ns" << endl;
+    }
+
+    cout << "\n26. Testing succinct LOUDS trie:" << endl;
+    cout << "=================================" << endl;
+    {
+        Trie small;
+        for (string word : {"to", "tea", "ted", "ten", "i", "in", "inn", "A", "A-1"})
+            small.insert(word);
+        small.insert("tea");
+        LoudsTrie frozen(small);
+
+        cout << "Search 'ten': " << (frozen.search("ten") ? "FOUND" : "NOT FOUND") << " (expected: FOUND)" << endl;
+        cout << "Search 'te': " << (frozen.search("te") ? "FOUND" : "NOT FOUND") << " (expected: NOT FOUND)" << endl;
+        cout << "Starts with 'A-': " << (frozen.startsWith("A-") ? "YES" : "NO") << " (expected: YES)" << endl;
+        cout << "Prefix count 't': " << frozen.prefixCount("t") << " (expected: 4)" << endl;
+        cout << "Prefix count '': " << frozen.prefixCount("") << " (expected: 9)" << endl;
+        cout << "Frequency of 'tea': " << frozen.getFrequency("tea") << " (expected: 2)" << endl;
+        cout << "Longest prefix match 'innkeeper': " << frozen.LongestPrefixMatch("innkeeper") << " (expected: inn)"
+             << endl;
+        cout << "Autocomplete 'te': ";
+        for (auto &entry : frozen.autocomplete("te"))
+            cout << entry.first << " ";
+        cout << "(expected: tea ted ten)" << endl;
+    }
+    {
+        // Dictionary-like keys: common stems with varied endings and some non-letter bytes
+        mt19937 rng(26);
+        vector<string> stems;
+        for (int i = 0; i < 3000; i++)
+        {
+            string stem;
+            int len = 2 + rng() % 5;
+            for (int j = 0; j < len; j++)
+                stem += (char)('a' + rng() % 26);
+            stems.push_back(stem);
+        }
+        const vector<string> endings = {"", "s", "ed", "ing", "er", "ers", "ly", "ness", "-x", "_1", "2"};
+
+        Trie pointerTrie;
+        vector<string> keys;
+        for (int i = 0; i < 300000; i++)
+        {
+            string key = stems[rng() % stems.size()] + stems[rng() % stems.size()] + endings[rng() % endings.size()];
+            if (pointerTrie.insert(key))
+                keys.push_back(key);
+        }
+        for (int i = 0; i < 100000; i++)
+            pointerTrie.search(keys[rng() % 1000]);
+
+        LoudsTrie frozen(pointerTrie);
+
+        // Compare before timing, since Trie::search changes the search counts
+        int mismatches = 0;
+        for (int i = 0; i < 2000; i++)
+        {
+            string prefix = keys[rng() % keys.size()].substr(0, 1 + rng() % 5);
+            auto expected = pointerTrie.autocomplete(prefix);
+            auto actual = frozen.autocomplete(prefix);
+            mismatches += expected.size() != actual.size();
+            for (size_t j = 0; j < min<size_t>(10, min(expected.size(), actual.size())); j++)
+                mismatches += expected[j].second != actual[j].second;
+            mismatches += pointerTrie.prefixCount(prefix) != frozen.prefixCount(prefix);
+        }
+
+        vector<string> queries;
+        for (int i = 0; i < 200000; i++)
+        {
+            string key = keys[rng() % keys.size()];
+            if (i % 2)
+                key.back() = (char)('a' + rng() % 26);
+            queries.push_back(key);
+        }
+        for (int i = 0; i < 20000; i++)
+        {
+            const string &query = queries[i];
+            mismatches += pointerTrie.getFrequency(query) != frozen.getFrequency(query);
+            mismatches += pointerTrie.startsWith(query) != frozen.startsWith(query);
+            mismatches += pointerTrie.LongestPrefixMatch(query + "zz") != frozen.LongestPrefixMatch(query + "zz");
+            mismatches += (pointerTrie.getFrequency(query) > 0) != frozen.search(query);
+        }
+        cout << "Words: " << frozen.size() << ", nodes: " << frozen.nodeCount()
+             << ", results differing from the pointer trie: " << mismatches << " (expected: 0)" << endl;
+
+        cout << "Bits per key: pointer trie " << pointerTrie.memoryUsage() * 8.0 / keys.size() << ", LOUDS "
+             << frozen.memoryBytes() * 8.0 / keys.size() << " (" << frozen.memoryBytes() * 8.0 / frozen.nodeCount()
+             << " bits per node)" << endl;
+
+        auto timeSearches = [&](auto lookup)
+        {
+            auto startTime = chrono::steady_clock::now();
+            int hits = 0;
+            for (const string &query : queries)
+                hits += lookup(query);
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+            return make_pair(hits, seconds * 1e9 / queries.size());
+        };
+        auto pointerResult = timeSearches([&](const string &query)
+                                          { return pointerTrie.search(query); });
+        auto loudsResult = timeSearches([&](const string &query)
+                                        { return frozen.search(query); });
+        cout << "Hits: " << pointerResult.first << " / " << loudsResult.first << " (expected: equal)" << endl;
+        cout << "Search latency: pointer trie " << pointerResult.second << " ns, LOUDS " << loudsResult.second << " ns"
+             << endl;
+    }
+
+    cout << "\n27. Testing double-array trie:" << endl;
+    cout << "===============================" << endl;
+    {
+        Trie small;
+        for (string word : {"car", "card", "care", "cat", "Cab", "c++", "dog"})
+            small.insert(word);
+        DoubleArrayTrie compiled(small);
+
+        cout << "Search 'care': " << (compiled.search("care") ? "FOUND" : "NOT FOUND") << " (expected: FOUND)" << endl;
+        cout << "Search 'ca': " << (compiled.search("ca") ? "FOUND" : "NOT FOUND") << " (expected: NOT FOUND)" << endl;
+        cout << "Search 'c++': " << (compiled.search("c++") ? "FOUND" : "NOT FOUND") << " (expected: FOUND)" << endl;
+        cout << "Prefix count 'car': " << compiled.prefixCount("car") << " (expected: 3)" << endl;
+        cout << "Longest prefix match 'cardigan': " << compiled.LongestPrefixMatch("cardigan") << " (expected: card)"
+             << endl;
+
+        // New codes under existing states may collide and relocate the children
+        cout << "Insert 'cab' (new): " << (compiled.insert("cab") ? "true" : "false") << " (expected: true)" << endl;
+        cout << "Insert 'car' (duplicate): " << (compiled.insert("car") ? "true" : "false") << " (expected: false)"
+             << endl;
+        compiled.insert("ca");
+        compiled.insert("cz");
+        compiled.insert("c#");
+        cout << "Frequency of 'car': " << compiled.getFrequency("car") << " (expected: 2)" << endl;
+        cout << "Autocomplete 'ca': ";
+        for (auto &entry : compiled.autocomplete("ca"))
+            cout << entry.first << " ";
+        cout << "(expected: care ca cab car card cat)" << endl;
+        cout << "Words after inserts: " << compiled.size() << " (expected: 11)" << endl;
+        cout << "Prefix count 'ca' after inserts: " << compiled.prefixCount("ca") << " (expected: 6)" << endl;
+        cout << "Prefix count '': " << compiled.prefixCount("") << " (expected: 11)" << endl;
+    }
+    {
+        // Routing-table-like keys: shared stems, mixed bytes
+        mt19937 rng(27);
+        vector<string> stems;
+        for (int i = 0; i < 2000; i++)
+        {
+            string stem;
+            int len = 2 + rng() % 5;
+            for (int j = 0; j < len; j++)
+                stem += (char)(rng() % 4 ? 'a' + rng() % 26 : "./-_:0123456789ABCDEF"[rng() % 21]);
+            stems.push_back(stem);
+        }
+
+        Trie pointerTrie;
+        vector<string> keys;
+        for (int i = 0; i < 200000; i++)
+        {
+            string key = stems[rng() % stems.size()] + "/" + stems[rng() % stems.size()];
+            if (pointerTrie.insert(key))
+                keys.push_back(key);
+        }
+
+        auto startTime = chrono::steady_clock::now();
+        DoubleArrayTrie compiled(pointerTrie);
+        double buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+        // Grow both incrementally
+        int mismatches = 0;
+        for (int i = 0; i < 20000; i++)
+        {
+            string key = stems[rng() % stems.size()] + "#" + to_string(rng() % 1000);
+            mismatches += pointerTrie.insert(key) != compiled.insert(key);
+            keys.push_back(key);
+        }
+
+        for (size_t i = 0; i < keys.size(); i += 7)
+            mismatches += compiled.getFrequency(keys[i]) != pointerTrie.getFrequency(keys[i]);
+        for (int i = 0; i < 2000; i++)
+        {
+            string prefix = keys[rng() % keys.size()].substr(0, 1 + rng() % 4);
+            mismatches += compiled.prefixCount(prefix) != pointerTrie.prefixCount(prefix);
+            mismatches += compiled.autocomplete(prefix).size() != pointerTrie.autocomplete(prefix).size();
+            mismatches += compiled.startsWith(prefix + "~") != pointerTrie.startsWith(prefix + "~");
+        }
+        cout << "Words: " << compiled.size() << " (pointer trie: " << pointerTrie.countWords()
+             << "), results differing: " << mismatches << " (expected: 0)" << endl;
+        cout << "Build: " << buildSeconds * 1000 << " ms, slot occupancy: " << compiled.occupancy() * 100
+             << "%, memory: " << compiled.memoryBytes() / (1 << 20) << " MiB (pointer trie estimate: "
+             << pointerTrie.memoryUsage() / (1 << 20) << " MiB)" << endl;
+
+        auto makeQueries = [&](int hitPercent)
+        {
+            vector<string> queries;
+            for (int i = 0; i < 300000; i++)
+            {
+                string key = keys[rng() % keys.size()];
+                if ((int)(rng() % 100) >= hitPercent)
+                    key[rng() % key.size()] = (char)('A' + rng() % 58);
+                queries.push_back(key);
+            }
+            return queries;
+        };
+
+        for (int hitPercent : {90, 10})
+        {
+            vector<string> queries = makeQueries(hitPercent);
+            auto timeQueries = [&](auto lookup)
+            {
+                auto startTime = chrono::steady_clock::now();
+                size_t total = 0;
+                for (const string &query : queries)
+                    total += lookup(query);
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+                return make_pair(total, seconds * 1e9 / queries.size());
+            };
+
+            auto trieSearch = timeQueries([&](const string &query)
+                                          { return pointerTrie.search(query); });
+            auto arraySearch = timeQueries([&](const string &query)
+                                           { return compiled.search(query); });
+            auto trieMatch = timeQueries([&](const string &query)
+                                         { return pointerTrie.LongestPrefixMatch(query).size(); });
+            auto arrayMatch = timeQueries([&](const string &query)
+                                          { return compiled.LongestPrefixMatch(query).size(); });
+
+            cout << hitPercent << "% hits: same answers: "
+                 << (trieSearch.first == arraySearch.first && trieMatch.first == arrayMatch.first ? "YES" : "NO")
+                 << " (expected: YES); search " << trieSearch.second << " -> " << arraySearch.second
+                 << " ns, longest prefix match " << trieMatch.second << " -> " << arrayMatch.second << " ns" << endl;
+        }
+    }
+
     cout << "\n=== ALL TESTS COMPLETED ===" << endl;
 
     return 0;
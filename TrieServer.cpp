@@ -0,0 +1,730 @@
+#include "trie.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_set>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Autocomplete query server
+//
+// Line protocol, one request per line, one response line per request:
+//   AC <prefix> [k]   -> OK <word> <word> ...   (top k by search frequency, default 10)
+//   SEARCH <word>     -> OK 1 | OK 0
+//   PREFIX <prefix>   -> OK <count>
+//   RELOAD            -> OK reloading           (rebuild from the startup word file, swap in when done)
+//                        ERR reload in progress (a reload is already running)
+//   anything else     -> ERR <reason>
+//
+// One epoll thread owns all sockets. Every complete line read during one
+// epoll round becomes part of a batch; the batch is split by the first
+// letter of its key, and each worker of the pool answers one share. Keys
+// with different first letters live in disjoint subtrees, so workers never
+// touch the same nodes (search updates searchFreq), and each worker walks
+// a small part of the trie that stays hot in its cache.
+// SIGHUP reloads the word file given at startup.
+
+// A parsed request waiting in a batch
+struct Query
+{
+    int fd;
+    unsigned long long connId;
+    string command;
+    string key;
+    int k;
+    string response;
+};
+
+// One client connection
+struct Connection
+{
+    unsigned long long id;
+    string in;
+    string out;
+    bool writing;
+    // The peer has shut down its side; close once every request it sent is answered
+    bool peerClosed;
+};
+
+// Fixed pool of worker threads that run one batch at a time
+class WorkerPool
+{
+private:
+    vector<thread> threads;
+    mutex lock;
+    // One wake-up per worker, so a batch only wakes the workers that have a share of it
+    vector<unique_ptr<condition_variable>> wakes;
+    vector<bool> ready;
+    condition_variable finished;
+    function<void(int)> task;
+    int pending;
+    bool stopping;
+
+    // Worker loop
+    // Input: worker index
+    // Output: none
+    // Purpose: Wait for a batch, run this worker's share, report completion
+    void work(int index)
+    {
+        while (true)
+        {
+            function<void(int)> current;
+            {
+                unique_lock<mutex> guard(lock);
+                wakes[index]->wait(guard, [&]()
+                                   { return stopping || ready[index]; });
+                if (stopping)
+                    return;
+                ready[index] = false;
+                current = task;
+            }
+
+            current(index);
+
+            unique_lock<mutex> guard(lock);
+            if (--pending == 0)
+                finished.notify_one();
+        }
+    }
+
+public:
+    // Constructor
+    // Input: number of worker threads
+    // Output: none
+    // Purpose: Start the workers
+    WorkerPool(int count)
+    {
+        pending = 0;
+        stopping = false;
+        ready.assign(count, false);
+        for (int i = 0; i < count; i++)
+        {
+            wakes.emplace_back(new condition_variable());
+        }
+        for (int i = 0; i < count; i++)
+        {
+            threads.emplace_back(&WorkerPool::work, this, i);
+        }
+    }
+
+    // Number of workers
+    int size()
+    {
+        return threads.size();
+    }
+
+    // Run a task on some of the workers and wait for them
+    // Input: task(workerIndex), indexes of the workers to run it on
+    // Output: none
+    // Purpose: Process one batch in parallel; idle workers stay asleep
+    void run(function<void(int)> fn, const vector<int> &workers)
+    {
+        unique_lock<mutex> guard(lock);
+        task = fn;
+        pending = workers.size();
+        for (int index : workers)
+        {
+            ready[index] = true;
+            wakes[index]->notify_one();
+        }
+        finished.wait(guard, [&]()
+                      { return pending == 0; });
+    }
+
+    // Destructor
+    // Input: none
+    // Output: none
+    // Purpose: Stop and join the workers
+    ~WorkerPool()
+    {
+        {
+            unique_lock<mutex> guard(lock);
+            stopping = true;
+            for (auto &wake : wakes)
+            {
+                wake->notify_one();
+            }
+        }
+        for (thread &worker : threads)
+        {
+            worker.join();
+        }
+    }
+};
+
+// Build a Trie from a word file
+// Input: path to a file with one word per line (repeats raise the insert frequency)
+// Output: the new Trie, or nullptr if the file cannot be read
+// Purpose: Load the dictionary for startup and for hot reloads
+shared_ptr<Trie> loadTrie(const string &path)
+{
+    ifstream file(path);
+    if (!file)
+        return nullptr;
+
+    shared_ptr<Trie> trie = make_shared<Trie>();
+    string word;
+    while (getline(file, word))
+    {
+        if (!word.empty() && word.back() == '\r')
+            word.pop_back();
+        if (!word.empty())
+            trie->insert(word);
+    }
+
+    return trie;
+}
+
+class TrieServer
+{
+private:
+    int epollFd;
+    int listenFd;
+    int signalFd;
+    unsigned long long nextConnId;
+    unordered_map<int, Connection> connections;
+
+    // Current dictionary; batches take a snapshot with atomic_load, reloads swap it with atomic_exchange
+    shared_ptr<Trie> current;
+    string wordFile;
+    thread loader;
+    atomic<bool> loading;
+    // Signalled whenever a batch drops its snapshot, so a reload can free the old trie
+    mutex snapshotLock;
+    condition_variable snapshotReleased;
+
+    WorkerPool pool;
+
+    static const size_t MAX_LINE = 4096;
+
+    // Helper function to switch a socket to non-blocking mode
+    static void setNonBlocking(int fd)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    // Helper function to reload the dictionary in the background
+    // Input: none (always the word file given at startup; clients cannot name a file)
+    // Output: false if a reload is already running, true otherwise
+    // Purpose: Build the new Trie off the event loop, swap it in, and free the old one
+    //          once the last batch using it has finished
+    bool startReload()
+    {
+        if (loading.exchange(true))
+            return false;
+
+        if (loader.joinable())
+            loader.join();
+
+        string path = wordFile;
+        loader = thread([this, path]()
+                        {
+                            shared_ptr<Trie> fresh = loadTrie(path);
+                            if (fresh)
+                            {
+                                shared_ptr<Trie> old = atomic_exchange(&current, fresh);
+                                cerr << "reloaded " << path << " (" << fresh->countWords() << " words)" << endl;
+
+                                // Free the old trie here rather than on the event loop
+                                unique_lock<mutex> guard(snapshotLock);
+                                snapshotReleased.wait(guard, [&]()
+                                                      { return old.use_count() == 1; });
+                                old.reset();
+                            }
+                            else
+                            {
+                                cerr << "reload failed: cannot read " << path << endl;
+                            }
+                            loading = false; });
+        return true;
+    }
+
+    // Helper function to parse one request line
+    // Input: line without the newline, connection it came from
+    // Output: the parsed Query
+    // Purpose: Split the command and its arguments
+    Query parse(const string &line, int fd, unsigned long long connId)
+    {
+        Query query;
+        query.fd = fd;
+        query.connId = connId;
+        query.k = 10;
+
+        istringstream fields(line);
+        fields >> query.command >> query.key;
+        int k;
+        if (fields >> k && k > 0)
+            query.k = k;
+
+        return query;
+    }
+
+    // Helper function to answer one query
+    // Input: trie snapshot, query to fill in
+    // Output: none
+    // Purpose: Run a read query against the trie and format the response line
+    static void answer(Trie &trie, Query &query)
+    {
+        if (query.command == "AC")
+        {
+            query.response = "OK";
+            for (auto &suggestion : trie.autocomplete(query.key, query.k))
+            {
+                query.response += " " + suggestion.first;
+            }
+        }
+        else if (query.command == "SEARCH")
+        {
+            query.response = trie.search(query.key) ? "OK 1" : "OK 0";
+        }
+        else if (query.command == "PREFIX")
+        {
+            query.response = "OK " + to_string(trie.prefixCount(query.key));
+        }
+        else
+        {
+            query.response = "ERR unknown command";
+        }
+    }
+
+    // Helper function to choose the worker for a query
+    // Input: query
+    // Output: worker index, or -1 if the query must run on the event loop
+    // Purpose: Queries that share a first letter share a worker; autocomplete falls back
+    //          from an uppercase letter to the lowercase subtree, so both map to one worker
+    int workerFor(const Query &query)
+    {
+        if (query.key.empty() || query.command == "RELOAD")
+            return -1;
+
+        return (unsigned char)tolower(query.key[0]) % pool.size();
+    }
+
+    // Helper function to run a batch of queries
+    // Input: batch of parsed queries
+    // Output: none (fills in each query's response)
+    // Purpose: Answer the batch on the worker pool against one trie snapshot
+    void processBatch(vector<Query> &batch)
+    {
+        shared_ptr<Trie> trie = atomic_load(&current);
+
+        vector<vector<int>> shares(pool.size());
+        vector<int> serial;
+        for (int i = 0; i < (int)batch.size(); i++)
+        {
+            int worker = workerFor(batch[i]);
+            if (worker == -1)
+                serial.push_back(i);
+            else
+                shares[worker].push_back(i);
+        }
+
+        vector<int> busy;
+        for (int worker = 0; worker < pool.size(); worker++)
+        {
+            if (!shares[worker].empty())
+                busy.push_back(worker);
+        }
+        if (!busy.empty())
+        {
+            pool.run([&](int worker)
+                     {
+                         for (int i : shares[worker])
+                             answer(*trie, batch[i]); },
+                     busy);
+        }
+
+        // Queries that touch the root (empty key) or the server itself
+        for (int i : serial)
+        {
+            Query &query = batch[i];
+            if (query.command == "RELOAD")
+            {
+                if (!query.key.empty())
+                    query.response = "ERR RELOAD takes no argument";
+                else
+                    query.response = startReload() ? "OK reloading" : "ERR reload in progress";
+            }
+            else
+            {
+                answer(*trie, query);
+            }
+        }
+
+        // A reload may be waiting for this snapshot to be the last reference to the old trie
+        trie.reset();
+        {
+            lock_guard<mutex> guard(snapshotLock);
+        }
+        snapshotReleased.notify_all();
+    }
+
+    // Helper function to close a connection
+    void closeConnection(int fd)
+    {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connections.erase(fd);
+    }
+
+    // Helper function to write pending output
+    // Input: connection file descriptor
+    // Output: none
+    // Purpose: Write as much as the socket takes; wait for EPOLLOUT if it is full
+    void flush(int fd)
+    {
+        auto it = connections.find(fd);
+        if (it == connections.end())
+            return;
+        Connection &conn = it->second;
+
+        while (!conn.out.empty())
+        {
+            ssize_t written = write(fd, conn.out.data(), conn.out.size());
+            if (written < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    break;
+                closeConnection(fd);
+                return;
+            }
+            conn.out.erase(0, written);
+        }
+
+        if (conn.peerClosed && conn.out.empty())
+        {
+            // Every request of a half-closed connection has been answered
+            closeConnection(fd);
+            return;
+        }
+
+        bool wantWrite = !conn.out.empty();
+        if (wantWrite != conn.writing)
+        {
+            conn.writing = wantWrite;
+            watch(fd, conn);
+        }
+    }
+
+    // Helper function to update the events epoll reports for a connection
+    // Input: connection file descriptor, its state
+    // Output: none
+    // Purpose: Readable while the peer may still send, writable while output is pending
+    void watch(int fd, const Connection &conn)
+    {
+        epoll_event event = {};
+        event.events = 0;
+        if (!conn.peerClosed)
+            event.events |= EPOLLIN;
+        if (conn.writing)
+            event.events |= EPOLLOUT;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    }
+
+    // Helper function to accept all pending connections
+    void acceptAll()
+    {
+        while (true)
+        {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0)
+                return;
+
+            setNonBlocking(fd);
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+
+            connections[fd] = {nextConnId++, "", "", false, false};
+        }
+    }
+
+    // Helper function to read from a connection
+    // Input: connection file descriptor, batch to append complete requests to
+    // Output: none
+    // Purpose: Read until the socket is drained or the peer has shut down, and turn
+    //          complete lines into queries. On end of file the complete lines are still
+    //          answered; the connection closes once their responses are written.
+    void readFrom(int fd, vector<Query> &batch)
+    {
+        Connection &conn = connections[fd];
+        char buffer[16384];
+
+        if (conn.peerClosed)
+        {
+            // Already at end of file, so this is a hangup or an error: nobody is left to answer
+            closeConnection(fd);
+            return;
+        }
+
+        while (true)
+        {
+            ssize_t got = read(fd, buffer, sizeof(buffer));
+            if (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                closeConnection(fd);
+                return;
+            }
+            if (got < 0)
+                break;
+            if (got == 0)
+            {
+                conn.peerClosed = true;
+                break;
+            }
+            conn.in.append(buffer, got);
+        }
+
+        size_t queued = batch.size();
+        size_t start = 0, end;
+        while ((end = conn.in.find('\n', start)) != string::npos)
+        {
+            string line = conn.in.substr(start, end - start);
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            batch.push_back(parse(line, fd, conn.id));
+            start = end + 1;
+        }
+        conn.in.erase(0, start);
+
+        if (conn.in.size() > MAX_LINE)
+        {
+            closeConnection(fd);
+            return;
+        }
+
+        if (conn.peerClosed)
+        {
+            // A trailing partial line can never complete
+            if (batch.size() == queued && conn.out.empty())
+                closeConnection(fd);
+            else
+                watch(fd, conn);
+        }
+    }
+
+public:
+    // Constructor
+    // Input: word file, listening socket, number of workers
+    // Output: none
+    // Purpose: Load the dictionary and set up epoll
+    TrieServer(const string &path, int listener, int workers) : pool(workers)
+    {
+        wordFile = path;
+        listenFd = listener;
+        nextConnId = 0;
+        loading = false;
+        current = loadTrie(path);
+        if (!current)
+            current = make_shared<Trie>();
+
+        epollFd = epoll_create1(0);
+
+        setNonBlocking(listenFd);
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+
+        // SIGHUP reloads the word file, SIGINT/SIGTERM stop the loop (blocked in main)
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGHUP);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        signalFd = signalfd(-1, &signals, SFD_NONBLOCK);
+        event.data.fd = signalFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, signalFd, &event);
+    }
+
+    // Run the event loop
+    // Input: none
+    // Output: none
+    // Purpose: Read requests, answer them in batches, write responses, until SIGINT/SIGTERM
+    void run()
+    {
+        vector<epoll_event> events(1024);
+
+        while (true)
+        {
+            int ready = epoll_wait(epollFd, events.data(), events.size(), -1);
+            if (ready < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                break;
+            }
+
+            vector<Query> batch;
+            for (int i = 0; i < ready; i++)
+            {
+                int fd = events[i].data.fd;
+
+                if (fd == listenFd)
+                {
+                    acceptAll();
+                }
+                else if (fd == signalFd)
+                {
+                    signalfd_siginfo info;
+                    while (read(signalFd, &info, sizeof(info)) == sizeof(info))
+                    {
+                        if (info.ssi_signo == SIGHUP)
+                            startReload();
+                        else
+                            return;
+                    }
+                }
+                else if (connections.count(fd))
+                {
+                    if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+                        readFrom(fd, batch);
+                    if (connections.count(fd) && (events[i].events & EPOLLOUT))
+                        flush(fd);
+                }
+            }
+
+            if (batch.empty())
+                continue;
+
+            processBatch(batch);
+
+            // Responses go out in request order; connections closed meanwhile are skipped
+            unordered_set<int> touched;
+            for (Query &query : batch)
+            {
+                auto it = connections.find(query.fd);
+                if (it == connections.end() || it->second.id != query.connId)
+                    continue;
+                it->second.out += query.response + "\n";
+                touched.insert(query.fd);
+            }
+            for (int fd : touched)
+            {
+                flush(fd);
+            }
+        }
+    }
+
+    // Destructor
+    // Input: none
+    // Output: none
+    // Purpose: Close all sockets and wait for a running reload
+    ~TrieServer()
+    {
+        if (loader.joinable())
+            loader.join();
+        for (auto &entry : connections)
+        {
+            close(entry.first);
+        }
+        close(signalFd);
+        close(epollFd);
+        close(listenFd);
+    }
+};
+
+// Main function
+// Input: word file, optional --port N (default 7070), --unix PATH, --workers N
+// Output: integer return code
+// Purpose: Parse arguments, open the listening socket and serve until interrupted
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        cerr << "usage: " << argv[0] << " <word-file> [--port N | --unix PATH] [--workers N]" << endl;
+        return 1;
+    }
+
+    string wordFile = argv[1];
+    int port = 7070;
+    string unixPath = "";
+    int workers = max(1u, thread::hardware_concurrency());
+
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        string flag = argv[i];
+        if (flag == "--port")
+            port = atoi(argv[i + 1]);
+        else if (flag == "--unix")
+            unixPath = argv[i + 1];
+        else if (flag == "--workers")
+            workers = max(1, atoi(argv[i + 1]));
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+
+    // Block the control signals before any thread starts so only the signalfd sees them
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGHUP);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    int listener;
+    if (!unixPath.empty())
+    {
+        listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, unixPath.c_str(), sizeof(address.sun_path) - 1);
+        unlink(unixPath.c_str());
+        if (bind(listener, (sockaddr *)&address, sizeof(address)) < 0)
+        {
+            perror("bind");
+            return 1;
+        }
+    }
+    else
+    {
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(listener, (sockaddr *)&address, sizeof(address)) < 0)
+        {
+            perror("bind");
+            return 1;
+        }
+    }
+
+    if (listen(listener, SOMAXCONN) < 0)
+    {
+        perror("listen");
+        return 1;
+    }
+
+    TrieServer server(wordFile, listener, workers);
+    cerr << "serving " << wordFile << " on " << (unixPath.empty() ? "127.0.0.1:" + to_string(port) : unixPath)
+         << " with " << workers << " workers" << endl;
+    server.run();
+
+    if (!unixPath.empty())
+        unlink(unixPath.c_str());
+
+    return 0;
+}
@@ -0,0 +1,3970 @@
+#ifndef TRIE_H
+#define TRIE_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <unordered_map>
+#include <stack>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cmath>
+#include <tuple>
+
+using namespace std;
+
+// Each node in the Trie
+class TrieNode
+{
+public:
+    // Each node has up to 26 children (for each letter)
+    TrieNode *children[26];
+    // Each node has a map to store children for extended characters
+    unordered_map<char, TrieNode *> mapchildren;
+
+    // Marks if this node completes a word
+    bool isEndOfWord;
+    int searchFreq;
+    int insertFreq;
+    // Number of words stored in the subtree rooted at this node (including itself)
+    int wordCount;
+    // Upper bound on the searchFreq of every word in this subtree, never below the bound of
+    // a child. Searches raise it with slack and deletions or aging do not lower it.
+    int maxSearchFreq;
+
+    // Constructor
+    TrieNode()
+    {
+        isEndOfWord = false;
+        searchFreq = 0;
+        insertFreq = 0;
+        wordCount = 0;
+        maxSearchFreq = 0;
+        for (int i = 0; i < 26; i++)
+        {
+            children[i] = nullptr;
+        }
+    }
+
+    bool hasChildren()
+    {
+        for (int i = 0; i < 26; i++)
+        {
+            if (children[i] != nullptr)
+            {
+                return true;
+            }
+        }
+        return !mapchildren.empty();
+    }
+};
+
+// Substring index kept alongside the Trie
+// Every word is split into its trigrams (3-byte substrings); each trigram keeps a
+// sorted posting list of the ids of the words that contain it. A substring query
+// intersects the lists of its trigrams and verifies the few remaining candidates.
+class InfixIndex
+{
+private:
+    // Word ids are handed out in increasing order and never reused, so appending
+    // an id keeps every posting list sorted
+    vector<string> words;
+    vector<TrieNode *> nodes; // terminal node of each word, nullptr once removed
+    unordered_map<string, int> idOf;
+    unordered_map<unsigned int, vector<int>> postings;
+    int removed;
+
+    static unsigned int gramAt(const string &word, size_t i)
+    {
+        return ((unsigned char)word[i] << 16) | ((unsigned char)word[i + 1] << 8) | (unsigned char)word[i + 2];
+    }
+
+    // Helper function to list the distinct trigrams of a string
+    // Input: string
+    // Output: vector of packed trigrams, sorted and without duplicates
+    // Purpose: Each word id is added to a posting list at most once
+    static vector<unsigned int> gramsOf(const string &word)
+    {
+        vector<unsigned int> grams;
+
+        for (size_t i = 0; i + 3 <= word.size(); i++)
+        {
+            grams.push_back(gramAt(word, i));
+        }
+
+        sort(grams.begin(), grams.end());
+        grams.erase(unique(grams.begin(), grams.end()), grams.end());
+        return grams;
+    }
+
+public:
+    // Constructor
+    InfixIndex()
+    {
+        removed = 0;
+    }
+
+    // Add a word to the index
+    // Input: word, its terminal node in the Trie
+    // Output: none
+    // Purpose: Append the new id to the posting list of every trigram of the word
+    void add(const string &word, TrieNode *node)
+    {
+        if (idOf.count(word))
+            return;
+
+        int id = words.size();
+        words.push_back(word);
+        nodes.push_back(node);
+        idOf[word] = id;
+
+        for (unsigned int gram : gramsOf(word))
+        {
+            postings[gram].push_back(id);
+        }
+    }
+
+    // Remove a word from the index
+    // Input: word
+    // Output: none
+    // Purpose: Drop the word's id from its posting lists
+    void remove(const string &word)
+    {
+        auto it = idOf.find(word);
+        if (it == idOf.end())
+            return;
+
+        int id = it->second;
+        idOf.erase(it);
+        nodes[id] = nullptr;
+        words[id].clear();
+        removed++;
+
+        for (unsigned int gram : gramsOf(word))
+        {
+            vector<int> &list = postings[gram];
+            list.erase(lower_bound(list.begin(), list.end(), id));
+            if (list.empty())
+                postings.erase(gram);
+        }
+    }
+
+    // Number of removed ids still holding a slot
+    int removedCount()
+    {
+        return removed;
+    }
+
+    // Number of words currently indexed
+    int size()
+    {
+        return idOf.size();
+    }
+
+    // Find words containing a substring
+    // Input: substring, maximum number of results k
+    // Output: up to k word-searchFreq pairs, most searched first
+    // Purpose: Answer infix queries without scanning every word
+    vector<pair<string, int>> contains(const string &substr, int k)
+    {
+        vector<pair<string, int>> result;
+
+        if (substr.size() < 3)
+        {
+            // Too short to have a trigram: scan the word table directly
+            for (size_t id = 0; id < words.size(); id++)
+            {
+                if (nodes[id] && words[id].find(substr) != string::npos)
+                    result.push_back({words[id], nodes[id]->searchFreq});
+            }
+        }
+        else
+        {
+            // Intersect the posting lists, shortest first
+            vector<vector<int> *> lists;
+            for (unsigned int gram : gramsOf(substr))
+            {
+                auto it = postings.find(gram);
+                if (it == postings.end())
+                    return {};
+                lists.push_back(&it->second);
+            }
+            sort(lists.begin(), lists.end(), [](vector<int> *a, vector<int> *b)
+                 { return a->size() < b->size(); });
+
+            vector<int> candidates = *lists[0];
+            for (size_t i = 1; i < lists.size() && !candidates.empty(); i++)
+            {
+                vector<int> kept;
+                set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(),
+                                 back_inserter(kept));
+                candidates.swap(kept);
+            }
+
+            // Trigrams match out of order too, so confirm the actual substring
+            for (int id : candidates)
+            {
+                if (words[id].find(substr) != string::npos)
+                    result.push_back({words[id], nodes[id]->searchFreq});
+            }
+        }
+
+        auto bySearchFreq = [](const pair<string, int> &a, const pair<string, int> &b)
+        { return a.second != b.second ? a.second > b.second : a.first < b.first; };
+
+        if ((int)result.size() > k)
+        {
+            partial_sort(result.begin(), result.begin() + k, result.end(), bySearchFreq);
+            result.resize(k);
+        }
+        else
+        {
+            sort(result.begin(), result.end(), bySearchFreq);
+        }
+
+        return result;
+    }
+
+    // Approximate heap usage of the index in bytes
+    size_t memoryBytes()
+    {
+        size_t bytes = words.capacity() * sizeof(string) + nodes.capacity() * sizeof(TrieNode *);
+
+        for (auto &word : words)
+        {
+            bytes += word.capacity() > 15 ? word.capacity() + 1 : 0;
+        }
+        // Hash nodes: key, value and next pointer, plus the bucket array
+        bytes += idOf.size() * (sizeof(pair<string, int>) + sizeof(void *)) + idOf.bucket_count() * sizeof(void *);
+        bytes += postings.size() * (sizeof(pair<unsigned int, vector<int>>) + sizeof(void *)) +
+                 postings.bucket_count() * sizeof(void *);
+        for (auto &entry : postings)
+        {
+            bytes += entry.second.capacity() * sizeof(int);
+        }
+
+        return bytes;
+    }
+};
+
+// Blocked Bloom filter over the stored words
+// All probe bits of a key fall into one 512-bit block (one cache line), so a
+// lookup costs a single memory access. A "no" is definite; a "yes" may be a
+// false positive at roughly the configured rate.
+class BloomFilter
+{
+private:
+    vector<unsigned long long> bits; // 8 words per block
+    size_t blockCount;
+    int probes;
+    size_t capacity;
+
+    // Murmur-style finalizer: spreads every input bit over the whole word
+    static unsigned long long mix(unsigned long long h)
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // 64-bit FNV-1a, mixed
+    static unsigned long long hashOf(const string &key)
+    {
+        unsigned long long h = 1469598103934665603ULL;
+        for (char c : key)
+        {
+            h ^= (unsigned char)c;
+            h *= 1099511628211ULL;
+        }
+        return mix(h);
+    }
+
+    // Helper function to get the i-th probe position inside a block
+    // Input: key hash, probe index
+    // Output: bit position in [0, 512)
+    // Purpose: Each 64-bit remix yields seven independent 9-bit positions
+    static unsigned int probeBit(unsigned long long &source, unsigned long long h, int i)
+    {
+        if (i % 7 == 0)
+            source = mix(h + 0x9e3779b97f4a7c15ULL * (i / 7 + 1));
+
+        return (source >> (9 * (i % 7))) & 511;
+    }
+
+public:
+    // Constructor
+    // Input: number of keys to size for, target false-positive rate
+    // Output: none
+    // Purpose: Pick bits per key and probe count from the target rate
+    BloomFilter(size_t expectedKeys, double falsePositiveRate)
+    {
+        const double LN2 = 0.6931471805599453;
+        double bitsPerKey = -log(falsePositiveRate) / (LN2 * LN2);
+
+        capacity = max<size_t>(expectedKeys, 1);
+        probes = min(16, max(1, (int)round(bitsPerKey * LN2)));
+        blockCount = max<size_t>(1, (size_t)ceil(capacity * bitsPerKey / 512));
+        bits.assign(blockCount * 8, 0);
+    }
+
+    // Add a key
+    void add(const string &key)
+    {
+        unsigned long long h = hashOf(key);
+        unsigned long long *block = &bits[h % blockCount * 8];
+        unsigned long long source = 0;
+
+        for (int i = 0; i < probes; i++)
+        {
+            unsigned int bit = probeBit(source, h, i);
+            block[bit >> 6] |= 1ULL << (bit & 63);
+        }
+    }
+
+    // Check whether a key may be stored
+    // Input: key
+    // Output: false if the key is definitely absent, true if it may be present
+    bool mayContain(const string &key)
+    {
+        unsigned long long h = hashOf(key);
+        const unsigned long long *block = &bits[h % blockCount * 8];
+        unsigned long long source = 0;
+
+        for (int i = 0; i < probes; i++)
+        {
+            unsigned int bit = probeBit(source, h, i);
+            if (!(block[bit >> 6] & (1ULL << (bit & 63))))
+                return false;
+        }
+        return true;
+    }
+
+    // Number of keys the filter was sized for
+    size_t sizedFor()
+    {
+        return capacity;
+    }
+
+    // Heap usage in bytes
+    size_t memoryBytes()
+    {
+        return bits.size() * sizeof(unsigned long long);
+    }
+};
+
+// The Trie class
+class Trie
+{
+    // Compiles the Trie's nodes into its own flat automaton
+    friend class AhoCorasick;
+    // Keeps pointers into the Trie between keystrokes
+    friend class TrieSession;
+    // Freezes the Trie's nodes into a succinct encoding
+    friend class LoudsTrie;
+    // Compiles the Trie's nodes into base/check arrays
+    friend class DoubleArrayTrie;
+    // Merges its per-thread tries and restores the indexes once at the end
+    friend class CorpusIngestor;
+
+private:
+    TrieNode *root;
+    // Optional substring index, nullptr until enableInfixIndex() is called
+    InfixIndex *infix;
+
+    // Optional negative-lookup filter, nullptr until enableNegativeFilter() is called
+    BloomFilter *filter;
+    double filterFalsePositiveRate;
+    // Deleted words whose bits are still set in the filter
+    int filterStale;
+
+    // Optional jump table: jumpTable[d - 1] is indexed by the first d bytes of a key
+    // and points at the depth-d node; jumpLevels is 0 until enableJumpTable() is called
+    static const int MAX_JUMP_LEVELS = 3;
+    vector<TrieNode *> jumpTable[MAX_JUMP_LEVELS];
+    int jumpLevels;
+
+    // Bumped by every change that adds words or frees or moves nodes, so holders of
+    // node pointers (TrieSession) can tell when theirs may be stale
+    unsigned long long version;
+
+    // Contiguous blocks of nodes written by optimize(), as (first node, capacity)
+    vector<pair<TrieNode *, size_t>> arenas;
+    // Number of top levels laid out breadth-first by optimize()
+    static const int BFS_LEVELS = 3;
+    // Arena slots whose node was freed; insert reuses them before allocating
+    vector<TrieNode *> arenaFree;
+    // Guards arenaFree, since set operations free nodes from several threads
+    mutex arenaLock;
+
+    // Live nodes and how many of them hang off a mapchildren entry
+    size_t nodeCount;
+    size_t mappedCount;
+    // Set by bulk changes without a budget; memoryUsage() recounts once before answering
+    bool memoryStale;
+    // Memory budget in bytes, 0 for unlimited
+    size_t budgetBytes;
+    int maxEvictionsPerInsert;
+    bool agingEnabled;
+    // xorshift64* state for eviction sampling
+    unsigned long long samplerState;
+
+    // Estimated cost of one mapchildren entry: the key/value pair plus the hash node's link and bucket slot
+    static const size_t MAP_ENTRY_BYTES = sizeof(pair<const char, TrieNode *>) + 2 * sizeof(void *);
+    // Words sampled per eviction; the least valuable of them is evicted
+    static const int EVICTION_SAMPLES = 5;
+
+    // Helper function to find all words from a node
+    // Input: current node, current word formed so far, results vector to store words
+    // Output: none (modifies results vector by reference)
+    // Purpose: Recursively find all complete words starting from the given node
+    void findAllWords(TrieNode *node, string currentWord, vector<pair<string, int>> &results)
+    {
+        if (!node)
+            return;
+
+        if (node->isEndOfWord)
+        {
+            results.push_back({currentWord, node->searchFreq});
+        }
+
+        for (int i = 0; i < 26; i++)
+        {
+            if (node->children[i] != nullptr)
+            {
+                char nxt = 'a' + i;
+                findAllWords(node->children[i], currentWord + nxt, results);
+            }
+        }
+
+        for (auto &entry : node->mapchildren)
+        {
+            findAllWords(entry.second, (currentWord + entry.first), results);
+        }
+    }
+
+    // Helper function to delete a word from the Trie
+    // Input: current node, word to delete, current depth in the word
+    // Output: boolean indicating whether the current node can be safely deleted
+    // Purpose: Recursively remove the word from the Trie and clean up unused nodes
+    bool deleteHelper(TrieNode *node, const string &word, int depth)
+    {
+        // If the node is a nullptr
+        if (!node)
+        {
+            return false;
+        }
+
+        // Reached the end of the word
+        if (depth == (int)word.size())
+        {
+            if (!node->isEndOfWord)
+                return false; // Word not found
+
+            node->isEndOfWord = false;
+            node->insertFreq--;
+
+            // Node can be deleted if it has no children
+            return !node->hasChildren();
+        }
+        //------------------------------------------------------------------
+
+        char c = word[depth];
+        TrieNode *childNode = nullptr;
+        bool isMapped = false; // Track whether we are using mapchildren
+
+        // Handle standard lowercase characters
+        if (c >= 'a' && c <= 'z')
+        {
+            childNode = node->children[c - 'a'];
+        }
+        else
+        {
+            // Extended characters handled here
+            if (node->mapchildren.count(c))
+            {
+                childNode = node->mapchildren[c];
+                isMapped = true;
+            }
+        }
+
+        // call the function for the child node
+        // true if the child node can be deleted
+        bool shouldDeleteChild = deleteHelper(childNode, word, depth + 1);
+
+        /*
+        if (wordExisted)
+            node->unifreq--;
+        */
+
+        // If child should be deleted, handle the deletion here
+        if (shouldDeleteChild)
+        {
+            freeNode(childNode);
+            nodeCount--;
+            mappedCount -= isMapped;
+
+            // Choose the right place to remove from
+            if (isMapped)
+            {
+                node->mapchildren.erase(c);
+            }
+            else
+            {
+                node->children[c - 'a'] = nullptr;
+            }
+        }
+
+        // Parent node can be deleted only if it's not a word AND has no children.
+        return !node->isEndOfWord && !node->hasChildren();
+    }
+
+    // Helper function to count words in the Trie
+    // Input: current node
+    // Output: integer count of words in the subtrie rooted at this node
+    // Purpose: Recursively count all unique words stored in the Trie
+    int countWordsHelper(TrieNode *node)
+    {
+        // 1. If node is null, return 0.
+        // 2. Add 1 if this node marks the end of a word.
+        // 3. Recursively check all 26 children.
+        // 4. Return the total count of words.
+
+        if (!node)
+            return 0;
+
+        int count = node->isEndOfWord; // bool -> 0 or 1
+
+        for (int i = 0; i < 26; i++)
+        {
+            if (node->children[i] != nullptr)
+            {
+                count += countWordsHelper(node->children[i]);
+            }
+        }
+
+        for (auto &entry : node->mapchildren)
+        {
+            count += countWordsHelper(entry.second);
+        }
+
+        return count;
+    }
+
+    // Helper function to find the longest word from a list of words
+    // Input: vector of word-frequency pairs
+    // Output: the longest word (string)
+    // Purpose: Identify the longest word from the provided list, breaking ties lexicographically
+    string LongestPrefixHelper(vector<pair<string, int>> &words)
+    {
+        string best = "";
+
+        for (auto &entry : words)
+        {
+            const string &word = entry.first;
+            if (word.length() > best.length() || (word.length() == best.length() && word < best))
+                best = word;
+        }
+
+        return best;
+    }
+
+    // Helper function to find all terminal nodes below a node
+    // Input: current node, current word formed so far, results vector of (word, node)
+    // Output: none (modifies results vector by reference)
+    // Purpose: Like findAllWords, but keeps the node so side indexes can point at it
+    void collectTerminals(TrieNode *node, string &currentWord, vector<pair<string, TrieNode *>> &results)
+    {
+        if (node->isEndOfWord)
+            results.push_back({currentWord, node});
+
+        for (auto &entry : childList(node))
+        {
+            currentWord.push_back(entry.first);
+            collectTerminals(entry.second, currentWord, results);
+            currentWord.pop_back();
+        }
+    }
+
+    // Helper function to rebuild the optional side indexes
+    // Input: none
+    // Output: none
+    // Purpose: Bring the indexes back in sync after bulk changes that free or move nodes
+    void rebuildIndexes()
+    {
+        version++;
+        rebuildFilter();
+        rebuildJumpTable();
+
+        if (!infix)
+            return;
+
+        vector<pair<string, TrieNode *>> terminals;
+        string word = "";
+        collectTerminals(root, word, terminals);
+
+        delete infix;
+        infix = new InfixIndex();
+        for (auto &entry : terminals)
+        {
+            infix->add(entry.first, entry.second);
+        }
+    }
+
+    // Helper function to fill the jump table below a node
+    // Input: current node, its depth, index formed by the bytes so far
+    // Output: none
+    // Purpose: Record every node of the first jumpLevels levels under its key bytes
+    void fillJumpTable(TrieNode *node, int depth, size_t index)
+    {
+        for (auto &entry : childList(node))
+        {
+            size_t childIndex = index << 8 | (unsigned char)entry.first;
+            jumpTable[depth][childIndex] = entry.second;
+
+            if (depth + 1 < jumpLevels)
+                fillJumpTable(entry.second, depth + 1, childIndex);
+        }
+    }
+
+    // Helper function to rebuild the jump table
+    // Input: none
+    // Output: none
+    // Purpose: Drop pointers to freed or moved nodes after bulk changes
+    void rebuildJumpTable()
+    {
+        for (int depth = 0; depth < jumpLevels; depth++)
+        {
+            jumpTable[depth].assign((size_t)1 << (8 * (depth + 1)), nullptr);
+        }
+
+        if (jumpLevels)
+            fillJumpTable(root, 0, 0);
+    }
+
+    // Helper function to refresh the jump table entries of one key
+    // Input: key that was just inserted or removed
+    // Output: none
+    // Purpose: Point each entry on the key's path at the node that exists now (nullptr once the path ends)
+    void updateJumpTable(const string &key)
+    {
+        TrieNode *node = root;
+        size_t index = 0;
+
+        for (int depth = 0; depth < jumpLevels && depth < (int)key.size(); depth++)
+        {
+            if (node)
+                node = childOf(node, key[depth]);
+
+            index = index << 8 | (unsigned char)key[depth];
+            jumpTable[depth][index] = node;
+        }
+    }
+
+    // Helper function to look up a prefix in the jump table
+    // Input: key, depth (1..jumpLevels, at most the key length)
+    // Output: the node reached by the first depth characters, or nullptr if there is none
+    TrieNode *jumpTo(const string &key, int depth)
+    {
+        size_t index = 0;
+
+        for (int i = 0; i < depth; i++)
+        {
+            index = index << 8 | (unsigned char)key[i];
+        }
+
+        return jumpTable[depth - 1][index];
+    }
+
+    // Helper function to find the node a key leads to
+    // Input: key
+    // Output: the node reached by the whole key, or nullptr if no stored word has this prefix
+    // Purpose: Shared descent that skips the first levels with one jump table access when enabled
+    TrieNode *findNode(const string &key)
+    {
+        TrieNode *node = root;
+        size_t i = 0;
+
+        if (jumpLevels && !key.empty())
+        {
+            i = min<size_t>(jumpLevels, key.size());
+            node = jumpTo(key, i);
+        }
+
+        for (; node && i < key.size(); i++)
+        {
+            node = childOf(node, key[i]);
+        }
+
+        return node;
+    }
+
+    // Helper function to rebuild the negative-lookup filter
+    // Input: none
+    // Output: none
+    // Purpose: Drop the bits of deleted words and resize for the current word count
+    void rebuildFilter()
+    {
+        if (!filter)
+            return;
+
+        vector<pair<string, int>> words;
+        findAllWords(root, "", words);
+
+        // Leave room to grow so inserts do not trigger a rebuild right away
+        delete filter;
+        filter = new BloomFilter(max<size_t>(1024, 2 * words.size()), filterFalsePositiveRate);
+        filterStale = 0;
+        for (auto &entry : words)
+        {
+            filter->add(entry.first);
+        }
+    }
+
+    // Helper function to remove a word known to be in the Trie
+    // Input: word to remove (must be stored)
+    // Output: the deleteHelper result for the root
+    // Purpose: Shared by deleteWord and eviction; keeps word counts and side indexes in sync.
+    //          Compaction of the side indexes is left to compactIndexes().
+    bool removeWord(const string &word)
+    {
+        version++;
+        if (infix)
+            infix->remove(word);
+
+        // The word exists, so every node on its path loses one word
+        TrieNode *node = root;
+        node->wordCount--;
+        for (char c : word)
+        {
+            node = childOf(node, c);
+            node->wordCount--;
+        }
+
+        // Call helper function to handle recursive deletion
+        bool deleteMe = deleteHelper(root, word, 0);
+
+        if (jumpLevels)
+            updateJumpTable(word);
+
+        if (filter)
+            filterStale++;
+
+        return deleteMe;
+    }
+
+    // Helper function to compact the side indexes after removals
+    // Input: none
+    // Output: none
+    // Purpose: Removed ids keep their slot in the infix index and deleted words stay set in the
+    //          filter; rebuild once either carries too much dead weight. Both stay correct
+    //          meanwhile, so eviction leaves this to deleteWord and compact() instead of
+    //          stalling an insert on a full rebuild.
+    void compactIndexes()
+    {
+        if (infix && infix->removedCount() > infix->size())
+            rebuildIndexes();
+        else if (filter && filterStale > max(1024, root->wordCount / 4))
+            rebuildFilter();
+    }
+
+    // Helper function to find the k-th word in sorted order
+    // Input: k (0-based, must be below root->wordCount), key to fill in
+    // Output: the word's terminal node (key receives the word), or nullptr if the
+    //         word counts are inconsistent and the walk runs out of children
+    // Purpose: Descend by subtree word counts; used by select and eviction sampling
+    TrieNode *selectNode(int k, string &key)
+    {
+        TrieNode *node = root;
+
+        while (node)
+        {
+            if (node->isEndOfWord)
+            {
+                if (k == 0)
+                    return node;
+                k--;
+            }
+
+            TrieNode *parent = node;
+            node = nullptr;
+            for (auto &entry : orderedChildren(parent))
+            {
+                if (k < entry.second->wordCount)
+                {
+                    key += entry.first;
+                    node = entry.second;
+                    break;
+                }
+                k -= entry.second->wordCount;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Helper function to recount live nodes
+    // Input: current node
+    // Output: none (updates nodeCount and mappedCount)
+    // Purpose: Resynchronize the memory counters after bulk changes
+    void recountMemory(TrieNode *node)
+    {
+        nodeCount++;
+        mappedCount += node->mapchildren.size();
+
+        for (auto &entry : childList(node))
+        {
+            recountMemory(entry.second);
+        }
+    }
+
+    // Helper function to draw a random number for eviction sampling
+    // Input: none
+    // Output: pseudo-random 64-bit value (xorshift64*)
+    unsigned long long nextSample()
+    {
+        samplerState ^= samplerState >> 12;
+        samplerState ^= samplerState << 25;
+        samplerState ^= samplerState >> 27;
+        return samplerState * 0x2545f4914f6cdd1dULL;
+    }
+
+    // Helper function to evict low-value words while over the memory budget
+    // Input: maximum number of words to evict, word that must not be evicted
+    // Output: none
+    // Purpose: Approximate least-valuable eviction: sample a few words uniformly
+    //          (select on a random rank) and evict the one with the lowest
+    //          insertFreq + searchFreq, preferring leaves because they free nodes.
+    //          With aging on, sampled survivors have their counts halved.
+    void evict(int limit, const string &keep)
+    {
+        for (int evicted = 0; evicted < limit && memoryUsage() > budgetBytes && root->wordCount > 0; evicted++)
+        {
+            vector<TrieNode *> sampled;
+            string victim;
+            TrieNode *victimNode = nullptr;
+            long long victimScore = 0;
+
+            for (int i = 0; i < EVICTION_SAMPLES; i++)
+            {
+                string key = "";
+                TrieNode *node = selectNode(nextSample() % root->wordCount, key);
+                if (!node || key == keep)
+                    continue;
+
+                long long score = 2LL * ((long long)node->insertFreq + node->searchFreq) + node->hasChildren();
+                if (!victimNode || score < victimScore)
+                {
+                    victim = key;
+                    victimNode = node;
+                    victimScore = score;
+                }
+                sampled.push_back(node);
+            }
+
+            if (!victimNode)
+                return;
+
+            if (agingEnabled)
+            {
+                for (TrieNode *node : sampled)
+                {
+                    if (node == victimNode)
+                        continue;
+                    node->insertFreq = max(1, node->insertFreq / 2);
+                    node->searchFreq /= 2;
+                }
+            }
+
+            removeWord(victim);
+        }
+    }
+
+    // Helper function to restore invariants after bulk changes
+    // Input: none
+    // Output: none
+    // Purpose: Rebuild side indexes and, under a memory budget, recount and enforce it.
+    //          Without a budget the recount waits for the next memoryUsage() call.
+    void afterBulkChange()
+    {
+        rebuildIndexes();
+        memoryStale = true;
+
+        if (budgetBytes)
+        {
+            nodeCount = 0;
+            mappedCount = 0;
+            recountMemory(root);
+            memoryStale = false;
+            evict(INT_MAX, "");
+        }
+    }
+
+    // Helper function to free one node
+    // Input: node that is no longer referenced
+    // Output: none
+    // Purpose: Nodes inside an optimize() arena are only destroyed; their slot goes
+    //          on the free list and the storage is released with the arena
+    void freeNode(TrieNode *node)
+    {
+        for (auto &arena : arenas)
+        {
+            if (node >= arena.first && node < arena.first + arena.second)
+            {
+                node->~TrieNode();
+                lock_guard<mutex> guard(arenaLock);
+                arenaFree.push_back(node);
+                return;
+            }
+        }
+
+        delete node;
+    }
+
+    // Helper function to allocate one node
+    // Input: none
+    // Output: a new empty node
+    // Purpose: Fill the holes deletions left in the arenas before asking the heap
+    TrieNode *newNode()
+    {
+        if (arenaFree.empty())
+            return new TrieNode();
+
+        TrieNode *slot = arenaFree.back();
+        arenaFree.pop_back();
+        return new (slot) TrieNode();
+    }
+
+    // Helper function to release every arena
+    // Input: none
+    // Output: none
+    // Purpose: Free arena storage once none of its nodes is live any more
+    void releaseArenas()
+    {
+        for (auto &arena : arenas)
+        {
+            ::operator delete(arena.first);
+        }
+        arenas.clear();
+        arenaFree.clear();
+    }
+
+    // Helper function to sum search frequencies per subtree
+    // Input: current node, map to fill
+    // Output: total searchFreq of the subtree
+    // Purpose: Rank children by how hot their subtree is
+    long long subtreeHeat(TrieNode *node, unordered_map<TrieNode *, long long> &heat)
+    {
+        long long total = node->isEndOfWord ? node->searchFreq : 0;
+
+        for (auto &entry : childList(node))
+        {
+            total += subtreeHeat(entry.second, heat);
+        }
+
+        heat[node] = total;
+        return total;
+    }
+
+    // Helper function to list children in layout order
+    // Input: node, subtree heat map (nullptr for plain key order)
+    // Output: children in key order, or hottest subtree first with ties in key order
+    vector<TrieNode *> layoutChildren(TrieNode *node, unordered_map<TrieNode *, long long> *heat)
+    {
+        vector<TrieNode *> result;
+        for (auto &entry : orderedChildren(node))
+        {
+            result.push_back(entry.second);
+        }
+
+        if (heat)
+        {
+            stable_sort(result.begin(), result.end(), [heat](TrieNode *a, TrieNode *b)
+                        { return (*heat)[a] > (*heat)[b]; });
+        }
+        return result;
+    }
+
+    // Helper function to append a subtree in depth-first order
+    // Input: subtree root, subtree heat map (nullptr for plain key order), output order
+    // Output: none
+    // Purpose: Every subtree becomes one run of memory; with a heat map the hottest child
+    //          directly follows its parent, so the common path stays together
+    void layoutDepthFirst(TrieNode *node, unordered_map<TrieNode *, long long> *heat, vector<TrieNode *> &order)
+    {
+        order.push_back(node);
+
+        for (TrieNode *child : layoutChildren(node, heat))
+        {
+            layoutDepthFirst(child, heat, order);
+        }
+    }
+
+    // Helper function to get the child of a node for a character
+    // Input: node, character
+    // Output: the child node, or nullptr if there is none
+    // Purpose: Hide the split between the fixed array and mapchildren
+    TrieNode *childOf(TrieNode *node, char c)
+    {
+        if (c >= 'a' && c <= 'z')
+            return node->children[c - 'a'];
+
+        auto it = node->mapchildren.find(c);
+        return it == node->mapchildren.end() ? nullptr : it->second;
+    }
+
+    // Helper function to attach or detach a child
+    // Input: node, character, new child (nullptr to detach)
+    // Output: none
+    // Purpose: Write to the fixed array or mapchildren depending on the character
+    void setChild(TrieNode *node, char c, TrieNode *child)
+    {
+        if (c >= 'a' && c <= 'z')
+            node->children[c - 'a'] = child;
+        else if (child)
+            node->mapchildren[c] = child;
+        else
+            node->mapchildren.erase(c);
+    }
+
+    // Helper function to list the children of a node
+    // Input: node
+    // Output: vector of (character, child) pairs
+    // Purpose: Snapshot the children so they can be modified while iterating
+    vector<pair<char, TrieNode *>> childList(TrieNode *node)
+    {
+        vector<pair<char, TrieNode *>> result;
+
+        for (int i = 0; i < 26; i++)
+        {
+            if (node->children[i])
+                result.push_back({(char)('a' + i), node->children[i]});
+        }
+
+        for (auto &entry : node->mapchildren)
+        {
+            result.push_back(entry);
+        }
+
+        return result;
+    }
+
+    // Helper function to recompute the word count of a node
+    // Input: node whose children's counts are up to date
+    // Output: none
+    // Purpose: Restore wordCount after a node's children were rearranged
+    void recount(TrieNode *node)
+    {
+        node->wordCount = node->isEndOfWord;
+        node->maxSearchFreq = node->isEndOfWord ? node->searchFreq : 0;
+
+        for (auto &entry : childList(node))
+        {
+            node->wordCount += entry.second->wordCount;
+            node->maxSearchFreq = max(node->maxSearchFreq, entry.second->maxSearchFreq);
+        }
+    }
+
+    // Helper function to raise the subtree search bounds along a word's path
+    // Input: word whose searchFreq outgrew its node's bound, new bound
+    // Output: none
+    // Purpose: Keep maxSearchFreq an upper bound. The root is skipped: the top-k walk never
+    //          prunes its start node, and searches under different first letters (the
+    //          server's workers) then never write to a shared node.
+    void raiseSearchBounds(const string &word, int bound)
+    {
+        TrieNode *node = root;
+        for (char c : word)
+        {
+            node = childOf(node, c);
+            node->maxSearchFreq = max(node->maxSearchFreq, bound);
+        }
+    }
+
+    // Helper function to find the node to complete a prefix from
+    // Input: prefix to complete
+    // Output: the prefix's node, or nullptr if no word starts with it
+    // Purpose: Shared prefix walk of the autocomplete variants; characters without an exact
+    //          child fall back to the lowercase child (case insensitive)
+    TrieNode *completionNode(const string &prefix)
+    {
+        TrieNode *node = root;
+        size_t i = 0;
+
+        // Exact prefixes can skip the first levels; a miss may still match
+        // case-insensitively, so it falls back to the walk below
+        if (jumpLevels && !prefix.empty())
+        {
+            int depth = min<int>(jumpLevels, prefix.size());
+            TrieNode *jumped = jumpTo(prefix, depth);
+            if (jumped)
+            {
+                node = jumped;
+                i = depth;
+            }
+        }
+
+        for (; i < prefix.size(); i++)
+        {
+            int charIndex = prefix[i];
+
+            // To easily modify according to the supported chars.
+            if ((charIndex >= 'a') && (charIndex <= 'z'))
+            {
+                charIndex = prefix[i] - 'a';
+
+                if (!node->children[charIndex])
+                    return nullptr;
+
+                node = node->children[charIndex];
+            }
+
+            // To handle characters other than lowercase.
+            // Case Insensitive
+            else
+            {
+                // Try mapchildren first
+                if (node->mapchildren.count(charIndex))
+                {
+                    node = node->mapchildren[charIndex];
+                }
+                else
+                {
+                    // Try lowercase children as fallback
+                    int index = tolower(charIndex) - 'a';
+                    if (index < 0 || index >= 26 || !node->children[index])
+                        return nullptr; // prefix not found
+                    node = node->children[index];
+                }
+            }
+        }
+
+        return node;
+    }
+
+    // Helper function to list the children of a node in key order
+    // Input: node
+    // Output: vector of (character, child) pairs sorted by unsigned byte value
+    // Purpose: Deterministic ordering that matches std::string comparison, including mapchildren
+    vector<pair<char, TrieNode *>> orderedChildren(TrieNode *node)
+    {
+        vector<pair<char, TrieNode *>> below, above;
+
+        for (auto &entry : node->mapchildren)
+        {
+            if ((unsigned char)entry.first < 'a')
+                below.push_back(entry);
+            else
+                above.push_back(entry);
+        }
+
+        auto byByte = [](const pair<char, TrieNode *> &a, const pair<char, TrieNode *> &b)
+        { return (unsigned char)a.first < (unsigned char)b.first; };
+        sort(below.begin(), below.end(), byByte);
+        sort(above.begin(), above.end(), byByte);
+
+        for (int i = 0; i < 26; i++)
+        {
+            if (node->children[i])
+                below.push_back({(char)('a' + i), node->children[i]});
+        }
+        below.insert(below.end(), above.begin(), above.end());
+
+        return below;
+    }
+
+    // Helper function to visit the words of a key range in order
+    // Input: current node, key formed so far, whether the key still equals a prefix of lo / hi,
+    //        range bounds, callback(word, searchFreq) returning false to stop
+    // Output: boolean, false once the walk should stop
+    // Purpose: Only descend into children that can hold keys in [lo, hi)
+    template <typename Callback>
+    bool rangeHelper(TrieNode *node, string &key, bool loTight, bool hiTight,
+                     const string &lo, const string &hi, Callback &callback)
+    {
+        size_t depth = key.size();
+
+        // key == lo: this word and everything below it is >= lo
+        if (loTight && depth == lo.size())
+            loTight = false;
+
+        // key == hi: this word and everything after it is >= hi
+        if (hiTight && depth == hi.size())
+            return false;
+
+        if (node->isEndOfWord && !loTight)
+        {
+            if (!callback(key, node->searchFreq))
+                return false;
+        }
+
+        for (auto &entry : orderedChildren(node))
+        {
+            unsigned char c = entry.first;
+            bool childLo = false, childHi = false;
+
+            if (loTight)
+            {
+                if (c < (unsigned char)lo[depth])
+                    continue;
+                childLo = c == (unsigned char)lo[depth];
+            }
+
+            if (hiTight)
+            {
+                if (c > (unsigned char)hi[depth])
+                    return false;
+                childHi = c == (unsigned char)hi[depth];
+            }
+
+            key.push_back(entry.first);
+            bool more = rangeHelper(entry.second, key, childLo, childHi, lo, hi, callback);
+            key.pop_back();
+
+            if (!more)
+                return false;
+        }
+
+        return true;
+    }
+
+    // Helper function to add the word counts of one terminal node to another
+    // Input: destination node, source node
+    // Output: none
+    // Purpose: Combine frequencies when the same word exists in both tries
+    void addFrequencies(TrieNode *dst, TrieNode *src)
+    {
+        if (!src->isEndOfWord)
+            return;
+
+        if (!dst->isEndOfWord)
+        {
+            // Stale counts can linger on nodes whose word was deleted
+            dst->insertFreq = 0;
+            dst->searchFreq = 0;
+        }
+
+        dst->isEndOfWord = true;
+        dst->insertFreq += src->insertFreq;
+        dst->searchFreq += src->searchFreq;
+    }
+
+    // Helper function to merge one subtree into another
+    // Input: destination node, source node (emptied, freed by the caller)
+    // Output: none
+    // Purpose: Walk both subtrees together, moving children that only exist in the source by pointer
+    void mergeHelper(TrieNode *dst, TrieNode *src)
+    {
+        addFrequencies(dst, src);
+
+        for (auto &entry : childList(src))
+        {
+            TrieNode *dstChild = childOf(dst, entry.first);
+
+            if (!dstChild)
+            {
+                setChild(dst, entry.first, entry.second);
+            }
+            else
+            {
+                mergeHelper(dstChild, entry.second);
+                freeNode(entry.second);
+            }
+        }
+
+        recount(dst);
+    }
+
+    // Helper function to move every word of another Trie into this one
+    // Input: Trie to merge from (left empty, must not be this Trie)
+    // Output: none
+    // Purpose: The merge itself, without restoring indexes or the memory budget afterwards,
+    //          so several merges in a row can share one afterBulkChange()
+    void mergeFrom(Trie &other)
+    {
+        addFrequencies(root, other.root);
+        other.root->isEndOfWord = false;
+
+        // Nodes moved over may live in the other Trie's arenas, and so do its free slots
+        arenas.insert(arenas.end(), other.arenas.begin(), other.arenas.end());
+        other.arenas.clear();
+        arenaFree.insert(arenaFree.end(), other.arenaFree.begin(), other.arenaFree.end());
+        other.arenaFree.clear();
+
+        vector<pair<char, pair<TrieNode *, TrieNode *>>> pairs;
+        for (auto &entry : childList(other.root))
+        {
+            TrieNode *mine = childOf(root, entry.first);
+
+            if (!mine)
+                setChild(root, entry.first, entry.second);
+            else
+                pairs.push_back({entry.first, {mine, entry.second}});
+
+            setChild(other.root, entry.first, nullptr);
+        }
+        // The other root is now an empty leaf; its word count and search bound must say so
+        recount(other.root);
+
+        forEachRootPair(pairs, [this](TrieNode *dst, TrieNode *src)
+                        {
+                            mergeHelper(dst, src);
+                            freeNode(src);
+                            return false; });
+    }
+
+    // Helper function to intersect one subtree with another
+    // Input: destination node, source node (nullptr if the source has no such subtree)
+    // Output: boolean indicating whether the destination node is now empty and can be deleted
+    // Purpose: Keep only the words present under both nodes
+    bool intersectHelper(TrieNode *dst, TrieNode *src)
+    {
+        if (dst->isEndOfWord)
+        {
+            if (src && src->isEndOfWord)
+            {
+                dst->insertFreq += src->insertFreq;
+                dst->searchFreq += src->searchFreq;
+            }
+            else
+            {
+                dst->isEndOfWord = false;
+            }
+        }
+
+        for (auto &entry : childList(dst))
+        {
+            TrieNode *srcChild = src ? childOf(src, entry.first) : nullptr;
+
+            if (intersectHelper(entry.second, srcChild))
+            {
+                freeNode(entry.second);
+                setChild(dst, entry.first, nullptr);
+            }
+        }
+
+        recount(dst);
+        return !dst->isEndOfWord && !dst->hasChildren();
+    }
+
+    // Helper function to subtract one subtree from another
+    // Input: destination node, source node
+    // Output: boolean indicating whether the destination node is now empty and can be deleted
+    // Purpose: Remove the words of the source subtree from the destination subtree
+    bool differenceHelper(TrieNode *dst, TrieNode *src)
+    {
+        if (dst->isEndOfWord && src->isEndOfWord)
+        {
+            dst->isEndOfWord = false;
+        }
+
+        for (auto &entry : childList(dst))
+        {
+            TrieNode *srcChild = childOf(src, entry.first);
+
+            if (srcChild && differenceHelper(entry.second, srcChild))
+            {
+                freeNode(entry.second);
+                setChild(dst, entry.first, nullptr);
+            }
+        }
+
+        recount(dst);
+        return !dst->isEndOfWord && !dst->hasChildren();
+    }
+
+    // Helper function to run a set operation on the root's children in parallel
+    // Input: (character, destination child, source child) triples, work(dst, src) returning "delete dst"
+    // Output: none
+    // Purpose: Root subtrees are disjoint, so each pair can be processed on its own thread;
+    //          the root itself is only modified afterwards, on the calling thread
+    template <typename Work>
+    void forEachRootPair(vector<pair<char, pair<TrieNode *, TrieNode *>>> &pairs, Work work)
+    {
+        vector<char> emptied(pairs.size(), false);
+        int threadCount = min<int>(max(1u, thread::hardware_concurrency()), pairs.size());
+        vector<thread> workers;
+
+        for (int t = 0; t < threadCount; t++)
+        {
+            workers.emplace_back([&, t]()
+                                 {
+                                     for (size_t i = t; i < pairs.size(); i += threadCount)
+                                     {
+                                         emptied[i] = work(pairs[i].second.first, pairs[i].second.second);
+                                     } });
+        }
+        for (thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        for (size_t i = 0; i < pairs.size(); i++)
+        {
+            if (emptied[i])
+            {
+                freeNode(pairs[i].second.first);
+                setChild(root, pairs[i].first, nullptr);
+            }
+        }
+
+        recount(root);
+    }
+
+public:
+    // Constructor
+    // Input: none
+    // Output: none
+    // Purpose: Initialize the Trie with a root node
+    Trie()
+    {
+        root = new TrieNode();
+        infix = nullptr;
+        filter = nullptr;
+        filterFalsePositiveRate = 0.01;
+        filterStale = 0;
+        jumpLevels = 0;
+        version = 0;
+        nodeCount = 1;
+        mappedCount = 0;
+        memoryStale = false;
+        budgetBytes = 0;
+        maxEvictionsPerInsert = 8;
+        agingEnabled = false;
+        samplerState = 0x9e3779b97f4a7c15ULL;
+    }
+
+    // Insert a word into the Trie
+    // Input: word to insert (string)
+    // Output: none
+    // Purpose: Add a word to the Trie by creating nodes for each character
+    bool insert(string word)
+    {
+        TrieNode *curr = root;
+
+        for (char c : word)
+        {
+            if (c >= 'a' && c <= 'z')
+            {
+                if (curr->children[c - 'a'] == nullptr)
+                {
+                    curr->children[c - 'a'] = newNode();
+                    nodeCount++;
+                }
+                curr = curr->children[c - 'a'];
+            }
+            else
+            {
+                if (!curr->mapchildren[c])
+                {
+                    curr->mapchildren[c] = newNode();
+                    nodeCount++;
+                    mappedCount++;
+                }
+                curr = curr->mapchildren[c];
+            }
+        }
+
+        curr->insertFreq++;
+        if (curr->isEndOfWord)
+        {
+            // Word already existed
+            return false; // duplicate
+        }
+        curr->isEndOfWord = true;
+        version++;
+
+        if (infix)
+            infix->add(word, curr);
+
+        // Count the new word in every subtree on its path
+        TrieNode *node = root;
+        node->wordCount++;
+        for (char c : word)
+        {
+            node = childOf(node, c);
+            node->wordCount++;
+        }
+
+        if (jumpLevels)
+            updateJumpTable(word);
+
+        if (filter)
+        {
+            filter->add(word);
+            if ((size_t)root->wordCount > filter->sizedFor())
+                rebuildFilter();
+        }
+
+        if (budgetBytes && memoryUsage() > budgetBytes)
+            evict(maxEvictionsPerInsert, word);
+
+        return true; // unique
+    }
+
+    // Get the frequency of a word in the Trie
+    // Input: word to check (string)
+    // Output: frequency count (integer)
+    // Purpose: Return how many times the word has been inserted into the Trie
+    int getFrequency(string word)
+    {
+        if (filter && !filter->mayContain(word))
+            return 0;
+
+        TrieNode *node = root;
+        for (char c : word)
+        {
+            if (c >= 'a' && c <= 'z')
+            {
+                if (!node->children[c - 'a'])
+                    return 0;
+
+                node = node->children[c - 'a'];
+            }
+            else
+            {
+                if (!node->mapchildren.count(c))
+                    return 0;
+
+                node = node->mapchildren[c];
+            }
+        }
+
+        if (node->isEndOfWord)
+            return node->insertFreq;
+
+        return 0;
+    }
+
+    // Count the total number of unique words in the Trie
+    // Input: none
+    // Output: integer count of unique words
+    // Purpose: Traverse the Trie and count how many unique words are stored
+    int countWords()
+    {
+        // 1. Start counting words from the root node.
+        // 2. Pass the root to the recursive helper.
+
+        return countWordsHelper(root);
+    }
+
+    // Count how many words start with the given prefix
+    // Input: prefix to check (string)
+    // Output: integer count of words with the prefix
+    // Purpose: Find how many complete words begin with the given prefix
+    int prefixCount(const string &prefix)
+    {
+        // Case Sensitive Search
+        TrieNode *node = findNode(prefix);
+
+        return node ? node->wordCount : 0;
+    }
+
+    // Return all words in lexicographical order
+    // Input: none
+    // Output: vector of words in lexicographical order
+    // Purpose: List all words stored in the Trie in sorted order
+    vector<pair<string, int>> Lexicographical()
+    {
+        vector<pair<string, int>> result;
+        TrieNode *node = root;
+        string curr = "";
+
+        findAllWords(node, curr, result);
+
+        return result;
+    }
+
+    // Get all words in the half-open key range [lo, hi)
+    // Input: lower bound (inclusive), upper bound (exclusive)
+    // Output: vector of word-searchFreq pairs in sorted order
+    // Purpose: Ordered range query for sharding and pagination
+    vector<pair<string, int>> range(const string &lo, const string &hi)
+    {
+        vector<pair<string, int>> result;
+
+        rangeEach(lo, hi, [&result](const string &word, int freq)
+                  {
+                      result.push_back({word, freq});
+                      return true; });
+
+        return result;
+    }
+
+    // Stream the words in the half-open key range [lo, hi)
+    // Input: lower bound (inclusive), upper bound (exclusive), callback(word, searchFreq) returning false to stop
+    // Output: none
+    // Purpose: Visit large ranges in sorted order without materializing them
+    template <typename Callback>
+    void rangeEach(const string &lo, const string &hi, Callback callback)
+    {
+        if (!(lo < hi))
+            return;
+
+        string key;
+        rangeHelper(root, key, true, true, lo, hi, callback);
+    }
+
+    // Count the words that sort before a key
+    // Input: key (does not need to be stored)
+    // Output: number of stored words strictly less than key
+    // Purpose: Rank query in O(depth * fanout) using subtree word counts
+    int rank(const string &key)
+    {
+        int count = 0;
+        TrieNode *node = root;
+
+        for (char c : key)
+        {
+            // The word ending here is a proper prefix of key, so it sorts first
+            if (node->isEndOfWord)
+                count++;
+
+            for (auto &entry : childList(node))
+            {
+                if ((unsigned char)entry.first < (unsigned char)c)
+                    count += entry.second->wordCount;
+            }
+
+            node = childOf(node, c);
+            if (!node)
+                return count;
+        }
+
+        return count;
+    }
+
+    // Get the k-th word in sorted order
+    // Input: k (0-based)
+    // Output: the word, or an empty string if k is out of range
+    // Purpose: Select query in O(depth * fanout) using subtree word counts
+    string select(int k)
+    {
+        if (k < 0 || k >= root->wordCount)
+            return "";
+
+        string key = "";
+        return selectNode(k, key) ? key : "";
+    }
+
+    // Search for a word in the Trie
+    // Input: word to search for (string)
+    // Output: boolean indicating if the word exists
+    // Purpose: Check if the complete word exists in the Trie
+    bool search(string word)
+    {
+        if (filter && !filter->mayContain(word))
+            return false;
+
+        // Case Sensitive Search
+        TrieNode *node = findNode(word);
+        if (!node)
+            return false;
+
+        if (node->isEndOfWord)
+        {
+            node->searchFreq++;
+
+            // Ancestors' bounds are at least this node's, so the path only needs a walk once the
+            // count passes it; half again as much headroom makes that rare for a hot word
+            if (node->searchFreq > node->maxSearchFreq)
+                raiseSearchBounds(word, node->searchFreq + node->searchFreq / 2);
+            return true;
+        }
+
+        return false;
+    }
+
+    // Check if any word starts with the given prefix
+    // Input: prefix to check (string)
+    // Output: boolean indicating if any word has this prefix
+    // Purpose: Verify if the prefix exists in the Trie (doesn't need to be a complete word)
+    bool startsWith(string prefix)
+    {
+        // Case Sensitive Search
+        return findNode(prefix) != nullptr;
+    }
+
+    static bool cmp(const pair<string, int> &a, const pair<string, int> &b)
+    {
+        return a.second > b.second;
+    }
+
+    // Get all words that start with the given prefix
+    // Input: prefix to complete (string)
+    // Output: vector of strings that start with the prefix
+    // Purpose: Find all complete words that begin with the given prefix
+    vector<pair<string, int>> autocomplete(string prefix)
+    {
+        // 1. Walk down to the start node to collect words from.
+        // 2. Use helper to collect all words from that node & return.
+        // 3. Sort suggestions by frequency (highest first).
+
+        vector<pair<string, int>> suggestions;
+
+        TrieNode *node = completionNode(prefix);
+        if (!node)
+            return {};
+
+        // Collect all words starting from this node.
+        findAllWords(node, prefix, suggestions);
+
+        // Sort suggestions by frequency (highest first).
+        sort(suggestions.begin(), suggestions.end(), cmp);
+
+        return suggestions;
+    }
+
+    // Get the k most searched words that start with the given prefix
+    // Input: prefix to complete (string), number of suggestions k
+    // Output: up to k word-frequency pairs, highest searchFreq first (ties in no particular order)
+    // Purpose: Best-first walk ordered by the subtrees' maxSearchFreq bounds. It stops once k
+    //          words are out, instead of collecting and sorting the whole subtree.
+    vector<pair<string, int>> autocomplete(string prefix, int k)
+    {
+        // Heap entries are (priority, is a word, node, word): a subtree is ranked by its bound,
+        // a word by its searchFreq. A word beats a subtree of equal rank, so ties never force
+        // a subtree to be expanded before the word is emitted.
+        typedef tuple<int, bool, TrieNode *, string> Entry;
+        auto lowerRank = [](const Entry &a, const Entry &b)
+        {
+            if (get<0>(a) != get<0>(b))
+                return get<0>(a) < get<0>(b);
+            return get<1>(a) < get<1>(b);
+        };
+
+        vector<pair<string, int>> suggestions;
+        TrieNode *start = completionNode(prefix);
+        if (!start || k <= 0)
+            return suggestions;
+
+        vector<Entry> heap;
+        heap.push_back(Entry(INT_MAX, false, start, prefix));
+
+        while (!heap.empty() && (int)suggestions.size() < k)
+        {
+            pop_heap(heap.begin(), heap.end(), lowerRank);
+            Entry top = move(heap.back());
+            heap.pop_back();
+
+            TrieNode *node = get<2>(top);
+            string &word = get<3>(top);
+            if (get<1>(top))
+            {
+                suggestions.push_back({word, node->searchFreq});
+                continue;
+            }
+
+            if (node->isEndOfWord)
+            {
+                heap.push_back(Entry(node->searchFreq, true, node, word));
+                push_heap(heap.begin(), heap.end(), lowerRank);
+            }
+
+            for (auto &entry : childList(node))
+            {
+                heap.push_back(Entry(entry.second->maxSearchFreq, false, entry.second, word + entry.first));
+                push_heap(heap.begin(), heap.end(), lowerRank);
+            }
+        }
+
+        return suggestions;
+    }
+
+    // Cap the memory used by the Trie's nodes
+    // Input: budget in bytes (0 disables the cap), words evicted at most per insert, whether to age counts
+    // Output: none
+    // Purpose: Once the estimated node footprint exceeds the budget, every insert evicts a few
+    //          low-value words (and their dead branches), so no single insert stalls. Index
+    //          compaction after evictions is left to deleteWord and compact().
+    void setMemoryBudget(size_t bytes, int evictionsPerInsert = 8, bool aging = false)
+    {
+        budgetBytes = bytes;
+        maxEvictionsPerInsert = max(1, evictionsPerInsert);
+        agingEnabled = aging;
+
+        nodeCount = 0;
+        mappedCount = 0;
+        recountMemory(root);
+        memoryStale = false;
+    }
+
+    // Estimated bytes held by live nodes
+    // Input: none
+    // Output: node bytes plus mapchildren entry bytes, plus arena slots freed but not yet reused
+    // Purpose: The footprint the memory budget is checked against; insert and delete keep the
+    //          counters current, so this only walks the Trie once after a bulk change
+    size_t memoryUsage()
+    {
+        if (memoryStale)
+        {
+            nodeCount = 0;
+            mappedCount = 0;
+            recountMemory(root);
+            memoryStale = false;
+        }
+
+        return (nodeCount + arenaFree.size()) * sizeof(TrieNode) + mappedCount * MAP_ENTRY_BYTES;
+    }
+
+    // Put a Bloom filter in front of search and getFrequency
+    // Input: target false-positive rate (memory grows as the rate shrinks)
+    // Output: none
+    // Purpose: Reject definite misses before descending the Trie; insert keeps it
+    //          up to date, deletions are batched into periodic rebuilds
+    void enableNegativeFilter(double falsePositiveRate = 0.01)
+    {
+        filterFalsePositiveRate = min(0.5, max(1e-6, falsePositiveRate));
+
+        if (!filter)
+            filter = new BloomFilter(1, filterFalsePositiveRate);
+
+        rebuildFilter();
+    }
+
+    // Heap usage of the negative-lookup filter in bytes (0 if not enabled)
+    size_t negativeFilterBytes()
+    {
+        return filter ? filter->memoryBytes() : 0;
+    }
+
+    // Index the first levels of the Trie directly
+    // Input: number of levels (1 to 3; the table for level d has 256^d entries,
+    //        so 2 levels cost 514 KiB and 3 levels 128 MiB on 64-bit)
+    // Output: none
+    // Purpose: search, startsWith, autocomplete, prefixCount and LongestPrefixMatch jump
+    //          straight to the node of a key's first bytes instead of walking the densest
+    //          levels; insert and deleteWord keep the table in sync
+    void enableJumpTable(int levels = 2)
+    {
+        for (int depth = 0; depth < MAX_JUMP_LEVELS; depth++)
+        {
+            vector<TrieNode *>().swap(jumpTable[depth]);
+        }
+
+        jumpLevels = max(0, min(levels, (int)MAX_JUMP_LEVELS));
+        rebuildJumpTable();
+    }
+
+    // Heap usage of the jump table in bytes (0 if not enabled)
+    size_t jumpTableBytes()
+    {
+        size_t bytes = 0;
+
+        for (int depth = 0; depth < jumpLevels; depth++)
+        {
+            bytes += jumpTable[depth].capacity() * sizeof(TrieNode *);
+        }
+
+        return bytes;
+    }
+
+    // Relayout the Trie into contiguous memory
+    // Input: hotFirst (default true) to order by search frequency, false for plain key order
+    // Output: none
+    // Purpose: Copy every node into one block. With hotFirst the top levels are laid out
+    //          breadth-first (every lookup visits them) and each remaining subtree
+    //          depth-first with the most searched child right after its parent, which suits
+    //          skewed point lookups. Without it the nodes go depth-first in key order, which
+    //          suits full-subtree walks (autocomplete, countWords, Lexicographical). Either
+    //          way each deep subtree is one run of memory. The mapchildren hash nodes are
+    //          copied in layout order but stay separate heap blocks. All operations keep
+    //          working on the new layout, and insert reuses the slots deletions free in the block.
+    void optimize(bool hotFirst = true)
+    {
+        // 1. With hotFirst, compute the searchFreq heat of every subtree.
+        // 2. Order the nodes: BFS over the top levels (hotFirst only), then DFS below.
+        // 3. Copy them into a fresh arena and rewire the child pointers.
+        // 4. Destroy the old nodes and release the old arenas.
+
+        unordered_map<TrieNode *, long long> heat;
+        unordered_map<TrieNode *, long long> *ranking = nullptr;
+        if (hotFirst)
+        {
+            subtreeHeat(root, heat);
+            ranking = &heat;
+        }
+
+        vector<TrieNode *> order;
+        vector<TrieNode *> level = layoutChildren(root, ranking);
+        for (int depth = 1; hotFirst && depth < BFS_LEVELS && !level.empty(); depth++)
+        {
+            vector<TrieNode *> nextLevel;
+            for (TrieNode *node : level)
+            {
+                order.push_back(node);
+                for (TrieNode *child : layoutChildren(node, ranking))
+                {
+                    nextLevel.push_back(child);
+                }
+            }
+            level.swap(nextLevel);
+        }
+        for (TrieNode *node : level)
+        {
+            layoutDepthFirst(node, ranking, order);
+        }
+
+        if (order.empty())
+            return;
+
+        TrieNode *arena = (TrieNode *)::operator new(order.size() * sizeof(TrieNode));
+        unordered_map<TrieNode *, TrieNode *> moved;
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            new (&arena[i]) TrieNode(*order[i]);
+            moved[order[i]] = &arena[i];
+        }
+
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            TrieNode *node = &arena[i];
+            for (int c = 0; c < 26; c++)
+            {
+                if (node->children[c])
+                    node->children[c] = moved[node->children[c]];
+            }
+            for (auto &entry : node->mapchildren)
+            {
+                entry.second = moved[entry.second];
+            }
+        }
+        for (auto &entry : childList(root))
+        {
+            setChild(root, entry.first, moved[entry.second]);
+        }
+
+        for (TrieNode *node : order)
+        {
+            freeNode(node);
+        }
+        releaseArenas();
+        arenas.push_back({arena, order.size()});
+
+        // The substring index and the jump table point at the old nodes
+        rebuildIndexes();
+    }
+
+    // Build the substring index
+    // Input: none
+    // Output: none
+    // Purpose: Index the current words by trigram; insert and deleteWord keep it up to date afterwards
+    void enableInfixIndex()
+    {
+        if (!infix)
+            infix = new InfixIndex();
+
+        rebuildIndexes();
+    }
+
+    // Get the words that contain a substring
+    // Input: substring to look for, maximum number of results k
+    // Output: up to k word-searchFreq pairs, most searched first
+    // Purpose: Infix search ("tab" finds "vegetable"); scans every word if the index is not enabled
+    vector<pair<string, int>> contains(const string &substr, int k)
+    {
+        if (infix)
+            return infix->contains(substr, k);
+
+        vector<pair<string, int>> result;
+        for (auto &entry : Lexicographical())
+        {
+            if (entry.first.find(substr) != string::npos)
+                result.push_back(entry);
+        }
+
+        sort(result.begin(), result.end(), [](const pair<string, int> &a, const pair<string, int> &b)
+             { return a.second != b.second ? a.second > b.second : a.first < b.first; });
+        if ((int)result.size() > k)
+            result.resize(k);
+
+        return result;
+    }
+
+    // Approximate heap usage of the substring index in bytes (0 if not enabled)
+    size_t infixIndexBytes()
+    {
+        return infix ? infix->memoryBytes() : 0;
+    }
+
+    // Find the longest word in the Trie
+    // Input: none
+    // Output: the longest word (string)
+    // Purpose: Traverse the Trie to find the longest word stored
+    string findLongestWord()
+    {
+        string best = "";
+        stack<pair<TrieNode *, string>> st;
+        st.push({root, ""});
+
+        while (!st.empty())
+        {
+            pair<TrieNode *, string> topPair = st.top();
+            TrieNode *node = st.top().first;
+            string curr = st.top().second;
+            st.pop();
+
+            if (node->isEndOfWord)
+            {
+                if (curr.size() > best.size() || (curr.size() == best.size() && curr < best))
+                    best = curr;
+            }
+
+            for (int i = 25; i >= 0; i--)
+            {
+                if (node->children[i])
+                {
+                    char c = 'a' + i;
+                    st.push({node->children[i], curr + c});
+                }
+            }
+
+            // Doesn't guarantee lexicographical order for mapchildren
+            for (auto &entry : node->mapchildren)
+            {
+                st.push({entry.second, curr + entry.first});
+            }
+        }
+
+        return best;
+    }
+
+    // Get the longest word that starts with the given prefix
+    // Input: prefix to match (string)
+    // Output: the longest matching word (string)
+    // Purpose: Find the longest complete word that begins with the given prefix
+    string longestWithPrefix(const string &prefix)
+    {
+        vector<pair<string, int>> words = autocomplete(prefix);
+        string match = LongestPrefixHelper(words);
+
+        return match;
+    }
+
+    // Find the longest prefix of the target that exists in the Trie
+    // Input: target string to match
+    // Output: the longest matching prefix (string)
+    // Purpose: Identify the longest prefix of the target string that is a complete word in the Trie
+    // N.B. This is different from longestWithPrefix which finds words starting with a given prefix.
+    // N.B. This function is used in applications like IP routing.
+    string LongestPrefixMatch(const string &target)
+    {
+        TrieNode *node = root;
+        string currentPrefix = "";
+        string longestPrefix = "";
+        size_t start = 0;
+
+        // The first levels come straight from the jump table; each of them may end a word
+        if (jumpLevels)
+        {
+            for (int depth = 1; depth <= jumpLevels && depth <= (int)target.size(); depth++)
+            {
+                node = jumpTo(target, depth);
+                if (!node)
+                    return longestPrefix;
+
+                if (node->isEndOfWord)
+                    longestPrefix = target.substr(0, depth);
+                start = depth;
+            }
+            currentPrefix = target.substr(0, start);
+        }
+
+        for (size_t i = start; i < target.size(); i++)
+        {
+            char c = target[i];
+
+            // Case Sensitive Search
+            if (c >= 'a' && c <= 'z')
+            {
+                if (!node->children[c - 'a'])
+                    break;
+
+                node = node->children[c - 'a'];
+            }
+            else
+            {
+                if (!node->mapchildren.count(c))
+                    break;
+
+                node = node->mapchildren[c];
+            }
+
+            currentPrefix += c;
+
+            if (node->isEndOfWord)
+            {
+                longestPrefix = currentPrefix;
+            }
+        }
+
+        return longestPrefix;
+    }
+
+    // Delete a word from the Trie
+    // Input: word to delete (string)
+    // Output: boolean indicating if deletion was successful
+    // Purpose: Removes the word from the Trie and cleans up unused nodes
+    bool deleteWord(string word)
+    {
+        // Handle empty strings
+        if (word.empty())
+            return false;
+
+        if (!search(word))
+            return false; // no need to call helper
+
+        bool deleted = removeWord(word);
+        compactIndexes();
+        return deleted;
+    }
+
+    // Compact the side indexes
+    // Input: none
+    // Output: none
+    // Purpose: Drop the dead weight eviction leaves in the infix index and negative filter;
+    //          call it from an idle point when a budgeted Trie sees few deleteWord calls
+    void compact()
+    {
+        compactIndexes();
+    }
+
+    // Merge another Trie into this one (union)
+    // Input: Trie to merge from (left empty afterwards)
+    // Output: none
+    // Purpose: Add every word of the other Trie, summing insertFreq and searchFreq of shared words.
+    //          Subtrees that only exist in the other Trie are moved by pointer, not copied.
+    void merge(Trie &other)
+    {
+        if (&other == this)
+            return;
+
+        mergeFrom(other);
+        afterBulkChange();
+        other.afterBulkChange();
+    }
+
+    // Intersect this Trie with another
+    // Input: Trie to intersect with (not modified)
+    // Output: none
+    // Purpose: Keep only the words that are also in the other Trie, summing their frequencies
+    void intersect(Trie &other)
+    {
+        if (&other == this)
+            return;
+
+        if (root->isEndOfWord)
+        {
+            if (other.root->isEndOfWord)
+            {
+                root->insertFreq += other.root->insertFreq;
+                root->searchFreq += other.root->searchFreq;
+            }
+            else
+            {
+                root->isEndOfWord = false;
+            }
+        }
+
+        vector<pair<char, pair<TrieNode *, TrieNode *>>> pairs;
+        for (auto &entry : childList(root))
+        {
+            pairs.push_back({entry.first, {entry.second, childOf(other.root, entry.first)}});
+        }
+
+        forEachRootPair(pairs, [this](TrieNode *dst, TrieNode *src)
+                        { return intersectHelper(dst, src); });
+
+        afterBulkChange();
+    }
+
+    // Subtract another Trie from this one
+    // Input: Trie whose words should be removed (not modified)
+    // Output: none
+    // Purpose: Remove every word that is also in the other Trie and clean up unused nodes
+    void difference(Trie &other)
+    {
+        if (&other == this)
+        {
+            clear(root);
+            releaseArenas();
+            root = new TrieNode();
+            nodeCount = 1;
+            mappedCount = 0;
+            rebuildIndexes();
+            return;
+        }
+
+        if (root->isEndOfWord && other.root->isEndOfWord)
+            root->isEndOfWord = false;
+
+        vector<pair<char, pair<TrieNode *, TrieNode *>>> pairs;
+        for (auto &entry : childList(root))
+        {
+            TrieNode *theirs = childOf(other.root, entry.first);
+
+            if (theirs)
+                pairs.push_back({entry.first, {entry.second, theirs}});
+        }
+
+        forEachRootPair(pairs, [this](TrieNode *dst, TrieNode *src)
+                        { return differenceHelper(dst, src); });
+
+        afterBulkChange();
+    }
+
+    // Clear the Trie to free memory
+    // Input: node to clear
+    // Output: void (none)
+    // Purpose: Recursively delete all nodes in the Trie
+    void clear(TrieNode *node)
+    {
+        if (!node)
+            return;
+
+        // Delete all 26 fixed children
+        for (int i = 0; i < 26; i++)
+        {
+            if (node->children[i])
+            {
+                clear(node->children[i]);
+            }
+        }
+
+        // Delete all map-based children
+        for (auto &pair : node->mapchildren)
+        {
+            clear(pair.second);
+        }
+
+        // Delete current node
+        freeNode(node);
+    }
+
+    // Destructor
+    // Input: none
+    // Output: none
+    // Purpose: Free all allocated memory when Trie is destroyed
+    ~Trie()
+    {
+        clear(root);
+        releaseArenas();
+        root = new TrieNode();
+        version++;
+        nodeCount = 1;
+        mappedCount = 0;
+        delete infix;
+        infix = nullptr;
+        delete filter;
+        filter = nullptr;
+        enableJumpTable(0);
+    }
+};
+
+// Cursor for keystroke-by-keystroke autocomplete
+// Input: the Trie to complete from (it must outlive the session), then keystrokes
+//        through push and pop
+// Output: suggestions(k), the k most searched words for the prefix typed so far
+// Purpose: Keep the node of every prefix length typed so far, so push and pop are
+//          O(1), and cache the ranked candidates of each length. Once a subtree
+//          holds at most FULL_LIST_LIMIT words its whole ranked list is kept, and
+//          longer prefixes filter that list instead of walking the Trie again;
+//          larger subtrees only keep their top k. pop returns to a length whose
+//          list is already there. Before touching any node the session compares
+//          the Trie's version: after an insert, delete or bulk change it re-walks
+//          the typed prefix and drops its caches, so it never follows a freed
+//          pointer. Frequencies in a cached list are the ones seen when it was
+//          collected.
+class TrieSession
+{
+private:
+    // State for one prefix length
+    struct Level
+    {
+        TrieNode *node = nullptr;  // nullptr once no stored word has the prefix
+        bool collected = false;    // candidates filled in
+        bool complete = false;     // candidates hold every word below node, not just the top limit
+        int limit = 0;             // k a partial list was collected for
+        vector<pair<string, int>> candidates;
+    };
+
+    // Subtrees up to this many words are cached in full
+    static const int FULL_LIST_LIMIT = 128;
+
+    Trie &trie;
+    unsigned long long version;
+    // Characters as typed, and as stored (uppercase may fall back to lowercase children)
+    string typed;
+    string stored;
+    // levels[d] describes the first d characters
+    vector<Level> levels;
+
+    // Helper function to rank two candidates
+    // Input: two word-searchFreq pairs
+    // Output: whether a comes first (higher searchFreq, then smaller word)
+    static bool ranksBefore(const pair<string, int> &a, const pair<string, int> &b)
+    {
+        if (a.second != b.second)
+            return a.second > b.second;
+        return a.first < b.first;
+    }
+
+    // Helper function to find the best k words of a subtree
+    // Input: current node, word formed so far, k, heap of the best words seen (worst on top)
+    // Output: none (modifies best by reference)
+    // Purpose: Only words that make it into the top k are copied out
+    void collectTop(TrieNode *node, string &word, size_t k, vector<pair<string, int>> &best)
+    {
+        if (node->isEndOfWord)
+        {
+            bool better = best.size() < k || node->searchFreq > best.front().second ||
+                          (node->searchFreq == best.front().second && word < best.front().first);
+            if (better)
+            {
+                if (best.size() == k)
+                {
+                    pop_heap(best.begin(), best.end(), ranksBefore);
+                    best.pop_back();
+                }
+                best.push_back({word, node->searchFreq});
+                push_heap(best.begin(), best.end(), ranksBefore);
+            }
+        }
+
+        for (int i = 0; i < 26; i++)
+        {
+            if (node->children[i])
+            {
+                word.push_back('a' + i);
+                collectTop(node->children[i], word, k, best);
+                word.pop_back();
+            }
+        }
+
+        for (auto &entry : node->mapchildren)
+        {
+            word.push_back(entry.first);
+            collectTop(entry.second, word, k, best);
+            word.pop_back();
+        }
+    }
+
+    // Helper function to re-walk the prefix after the Trie changed
+    // Input: none
+    // Output: none
+    // Purpose: Replace possibly freed node pointers and drop stale candidate lists
+    void revalidate()
+    {
+        if (version == trie.version)
+            return;
+
+        string prefix = typed;
+        clear();
+        for (char c : prefix)
+        {
+            push(c);
+        }
+    }
+
+    // Helper function to fill the candidate list of the deepest level
+    // Input: number of suggestions wanted
+    // Output: none
+    // Purpose: Filter the nearest complete ancestor list if there is one, otherwise collect from the node
+    void collect(int k)
+    {
+        int depth = levels.size() - 1;
+        Level &level = levels[depth];
+
+        int ancestor = depth - 1;
+        while (ancestor >= 0 && !(levels[ancestor].collected && levels[ancestor].complete))
+            ancestor--;
+
+        level.candidates.clear();
+        level.collected = true;
+
+        if (ancestor >= 0)
+        {
+            // Ranked order is kept by filtering
+            for (auto &entry : levels[ancestor].candidates)
+            {
+                if (entry.first.compare(0, depth, stored) == 0)
+                    level.candidates.push_back(entry);
+            }
+            level.complete = true;
+            return;
+        }
+
+        if (level.node->wordCount <= FULL_LIST_LIMIT)
+        {
+            vector<pair<string, TrieNode *>> terminals;
+            string word = stored;
+            trie.collectTerminals(level.node, word, terminals);
+            for (auto &entry : terminals)
+            {
+                level.candidates.push_back({move(entry.first), entry.second->searchFreq});
+            }
+            sort(level.candidates.begin(), level.candidates.end(), ranksBefore);
+            level.complete = true;
+        }
+        else
+        {
+            string word = stored;
+            collectTop(level.node, word, k, level.candidates);
+            sort_heap(level.candidates.begin(), level.candidates.end(), ranksBefore);
+            level.complete = false;
+            level.limit = k;
+        }
+    }
+
+public:
+    // Constructor
+    // Input: Trie to complete against (must outlive the session)
+    // Output: none
+    // Purpose: Start with an empty prefix
+    TrieSession(Trie &target) : trie(target)
+    {
+        clear();
+    }
+
+    // Forget the typed prefix
+    // Input: none
+    // Output: none
+    void clear()
+    {
+        typed.clear();
+        stored.clear();
+        levels.assign(1, Level());
+        levels[0].node = trie.root;
+        version = trie.version;
+    }
+
+    // Type one character
+    // Input: character
+    // Output: none
+    // Purpose: One child lookup; non-lowercase characters fall back to lowercase
+    //          children when there is no exact match, like autocomplete
+    void push(char c)
+    {
+        revalidate();
+
+        TrieNode *parent = levels.back().node;
+        TrieNode *child = nullptr;
+        char key = c;
+
+        if (parent)
+        {
+            child = trie.childOf(parent, c);
+
+            int index = tolower((unsigned char)c) - 'a';
+            if (!child && index >= 0 && index < 26)
+            {
+                child = parent->children[index];
+                key = 'a' + index;
+            }
+        }
+
+        typed.push_back(c);
+        stored.push_back(key);
+        levels.push_back(Level());
+        levels.back().node = child;
+    }
+
+    // Delete the last character
+    // Input: none
+    // Output: false if the prefix was already empty
+    bool pop()
+    {
+        if (typed.empty())
+            return false;
+
+        typed.pop_back();
+        stored.pop_back();
+        levels.pop_back();
+        return true;
+    }
+
+    // The prefix typed so far
+    const string &prefix()
+    {
+        return typed;
+    }
+
+    // Check whether any stored word starts with the typed prefix
+    // Input: none
+    // Output: boolean
+    bool hasMatches()
+    {
+        revalidate();
+        return levels.back().node != nullptr;
+    }
+
+    // Get the best completions of the typed prefix
+    // Input: maximum number of results k
+    // Output: up to k word-searchFreq pairs, most searched first (ties in word order)
+    // Purpose: Reuse the candidates of shorter prefixes where possible
+    vector<pair<string, int>> suggestions(int k)
+    {
+        revalidate();
+
+        Level &level = levels.back();
+        if (!level.node || k <= 0)
+            return {};
+
+        if (!level.collected || (!level.complete && level.limit < k))
+            collect(k);
+
+        size_t count = min(level.candidates.size(), (size_t)k);
+        return vector<pair<string, int>>(level.candidates.begin(), level.candidates.begin() + count);
+    }
+};
+
+// Each node in the TrieMap
+// Same child layout as TrieNode, but a terminal node only stores an index into the
+// map's value array, so internal nodes stay as small as they are in the plain Trie
+class TrieMapNode
+{
+public:
+    TrieMapNode *children[26];
+    unordered_map<char, TrieMapNode *> mapchildren;
+
+    // Index into TrieMap::values, -1 if this node does not complete a key
+    int valueIndex;
+    int searchFreq;
+    int insertFreq;
+
+    // Constructor
+    TrieMapNode()
+    {
+        valueIndex = -1;
+        searchFreq = 0;
+        insertFreq = 0;
+        for (int i = 0; i < 26; i++)
+        {
+            children[i] = nullptr;
+        }
+    }
+
+    bool hasChildren()
+    {
+        for (int i = 0; i < 26; i++)
+        {
+            if (children[i] != nullptr)
+            {
+                return true;
+            }
+        }
+        return !mapchildren.empty();
+    }
+};
+
+// Trie that maps each stored key to a value
+// Values live in one contiguous array indexed from the terminal nodes,
+// so a hit returns the payload directly without a second hash lookup
+template <typename T>
+class TrieMap
+{
+private:
+    TrieMapNode *root;
+
+    // Payloads, one per stored key, in no particular order
+    vector<T> values;
+    // owners[i] is the terminal node whose valueIndex is i
+    vector<TrieMapNode *> owners;
+
+    // Helper function to walk down to the node for a key
+    // Input: key to look up, whether missing nodes should be created
+    // Output: the node for the key, or nullptr if it does not exist
+    // Purpose: Shared descent for insert, find and autocomplete
+    TrieMapNode *walk(const string &key, bool create)
+    {
+        TrieMapNode *node = root;
+
+        for (char c : key)
+        {
+            if (c >= 'a' && c <= 'z')
+            {
+                if (!node->children[c - 'a'])
+                {
+                    if (!create)
+                        return nullptr;
+                    node->children[c - 'a'] = new TrieMapNode();
+                }
+                node = node->children[c - 'a'];
+            }
+            else
+            {
+                auto it = node->mapchildren.find(c);
+                if (it == node->mapchildren.end())
+                {
+                    if (!create)
+                        return nullptr;
+                    it = node->mapchildren.emplace(c, new TrieMapNode()).first;
+                }
+                node = it->second;
+            }
+        }
+
+        return node;
+    }
+
+    // Helper function to collect every key/value pair below a node
+    // Input: current node, key formed so far, results vector of (key, value, searchFreq)
+    // Output: none (modifies results vector by reference)
+    // Purpose: Recursively find all stored keys starting from the given node
+    void findAllItems(TrieMapNode *node, string currentKey, vector<pair<pair<string, T *>, int>> &results)
+    {
+        if (!node)
+            return;
+
+        if (node->valueIndex != -1)
+        {
+            results.push_back({{currentKey, &values[node->valueIndex]}, node->searchFreq});
+        }
+
+        for (int i = 0; i < 26; i++)
+        {
+            if (node->children[i] != nullptr)
+            {
+                char nxt = 'a' + i;
+                findAllItems(node->children[i], currentKey + nxt, results);
+            }
+        }
+
+        for (auto &entry : node->mapchildren)
+        {
+            findAllItems(entry.second, currentKey + entry.first, results);
+        }
+    }
+
+    // Helper function to release a value slot
+    // Input: terminal node whose value is being removed
+    // Output: none
+    // Purpose: Swap the last value into the freed slot so the array stays contiguous
+    void releaseValue(TrieMapNode *node)
+    {
+        int slot = node->valueIndex;
+        int last = values.size() - 1;
+
+        if (slot != last)
+        {
+            values[slot] = std::move(values[last]);
+            owners[slot] = owners[last];
+            owners[slot]->valueIndex = slot;
+        }
+
+        values.pop_back();
+        owners.pop_back();
+        node->valueIndex = -1;
+    }
+
+    // Helper function to erase a key from the TrieMap
+    // Input: current node, key to erase, current depth in the key
+    // Output: boolean indicating whether the current node can be safely deleted
+    // Purpose: Recursively remove the key and clean up unused nodes
+    bool eraseHelper(TrieMapNode *node, const string &key, size_t depth)
+    {
+        if (!node)
+            return false;
+
+        if (depth == key.size())
+        {
+            if (node->valueIndex == -1)
+                return false;
+
+            releaseValue(node);
+            node->insertFreq = 0;
+            node->searchFreq = 0;
+
+            return !node->hasChildren();
+        }
+
+        char c = key[depth];
+        TrieMapNode *childNode = nullptr;
+        bool isMapped = false;
+
+        if (c >= 'a' && c <= 'z')
+        {
+            childNode = node->children[c - 'a'];
+        }
+        else if (node->mapchildren.count(c))
+        {
+            childNode = node->mapchildren[c];
+            isMapped = true;
+        }
+
+        if (eraseHelper(childNode, key, depth + 1))
+        {
+            delete childNode;
+
+            if (isMapped)
+                node->mapchildren.erase(c);
+            else
+                node->children[c - 'a'] = nullptr;
+        }
+
+        return node->valueIndex == -1 && !node->hasChildren();
+    }
+
+    // Helper function to free a subtree
+    // Input: node to clear
+    // Output: none
+    // Purpose: Recursively delete all nodes below and including the given node
+    void clear(TrieMapNode *node)
+    {
+        if (!node)
+            return;
+
+        for (int i = 0; i < 26; i++)
+        {
+            if (node->children[i])
+                clear(node->children[i]);
+        }
+
+        for (auto &pair : node->mapchildren)
+        {
+            clear(pair.second);
+        }
+
+        delete node;
+    }
+
+public:
+    // Constructor
+    // Input: none
+    // Output: none
+    // Purpose: Initialize the TrieMap with a root node
+    TrieMap()
+    {
+        root = new TrieMapNode();
+    }
+
+    // The nodes are owned through raw pointers, so a shallow copy would free them twice
+    TrieMap(const TrieMap &) = delete;
+    TrieMap &operator=(const TrieMap &) = delete;
+
+    // Insert or update a key
+    // Input: key (string), value to associate with it
+    // Output: true if the key is new, false if an existing value was overwritten
+    // Purpose: Store the value in the contiguous value array and link it from the key's node
+    bool insert(const string &key, const T &value)
+    {
+        TrieMapNode *node = walk(key, true);
+        node->insertFreq++;
+
+        if (node->valueIndex != -1)
+        {
+            values[node->valueIndex] = value;
+            return false;
+        }
+
+        node->valueIndex = values.size();
+        values.push_back(value);
+        owners.push_back(node);
+        return true;
+    }
+
+    // Look up the value stored for a key
+    // Input: key to find (string)
+    // Output: pointer to the stored value, or nullptr if the key is absent
+    // Purpose: Single descent lookup; the pointer stays valid until the next insert or erase
+    T *find(const string &key)
+    {
+        TrieMapNode *node = walk(key, false);
+
+        if (!node || node->valueIndex == -1)
+            return nullptr;
+
+        node->searchFreq++;
+        return &values[node->valueIndex];
+    }
+
+    // Remove a key and its value
+    // Input: key to erase (string)
+    // Output: boolean indicating if the key was present
+    // Purpose: Free the value slot and clean up unused nodes
+    bool erase(const string &key)
+    {
+        TrieMapNode *node = walk(key, false);
+
+        if (!node || node->valueIndex == -1)
+            return false;
+
+        eraseHelper(root, key, 0);
+        return true;
+    }
+
+    // Get all key/value pairs whose key starts with the given prefix
+    // Input: prefix to complete (string)
+    // Output: vector of (key, value pointer) pairs, most searched first
+    // Purpose: Autocomplete that yields the payloads directly
+    vector<pair<string, T *>> autocomplete(const string &prefix)
+    {
+        vector<pair<pair<string, T *>, int>> found;
+        findAllItems(walk(prefix, false), prefix, found);
+
+        stable_sort(found.begin(), found.end(),
+                    [](const pair<pair<string, T *>, int> &a, const pair<pair<string, T *>, int> &b)
+                    { return a.second > b.second; });
+
+        vector<pair<string, T *>> suggestions;
+        for (auto &entry : found)
+        {
+            suggestions.push_back(entry.first);
+        }
+        return suggestions;
+    }
+
+    // Return every stored key with its value
+    // Input: none
+    // Output: vector of (key, value pointer) pairs in trie order
+    // Purpose: Iterate over keys and payloads together
+    vector<pair<string, T *>> items()
+    {
+        vector<pair<pair<string, T *>, int>> found;
+        findAllItems(root, "", found);
+
+        vector<pair<string, T *>> result;
+        for (auto &entry : found)
+        {
+            result.push_back(entry.first);
+        }
+        return result;
+    }
+
+    // Number of stored keys
+    int size()
+    {
+        return values.size();
+    }
+
+    // Iterate over the values only, straight from the contiguous array
+    typename vector<T>::iterator begin()
+    {
+        return values.begin();
+    }
+
+    typename vector<T>::iterator end()
+    {
+        return values.end();
+    }
+
+    // Destructor
+    // Input: none
+    // Output: none
+    // Purpose: Free all nodes; the values are released with the vector
+    ~TrieMap()
+    {
+        clear(root);
+    }
+};
+
+// Aho-Corasick multi-pattern scanner compiled from a Trie
+// Every word of the Trie becomes a pattern; one pass over the text reports all
+// occurrences of all patterns. The automaton is a flat transition table
+// (states x byte classes) with failure transitions already folded in, so each
+// input byte costs one table read. After construction it is read-only, so
+// independent buffers can be scanned from several threads at once.
+class AhoCorasick
+{
+public:
+    // Position of a stream being scanned
+    // Carry the same ScanState across consecutive chunks so that matches
+    // spanning a chunk boundary are still reported
+    struct ScanState
+    {
+        int state = 0;
+        size_t offset = 0; // bytes consumed so far
+    };
+
+private:
+    // Bytes that never occur in a pattern all share class 0
+    unsigned short classOf[256];
+    int numClasses;
+
+    // next[s * numClasses + cls] = state after reading a byte of class cls in state s
+    vector<int> next;
+    // First state on the output chain of s (s itself if terminal), -1 if none
+    vector<int> firstOut;
+    // Next terminal state on the failure chain, -1 if none
+    vector<int> outLink;
+    // Pattern id for terminal states, -1 otherwise
+    vector<int> patternOf;
+    vector<string> patterns;
+
+public:
+    // Constructor
+    // Input: populated Trie (not modified)
+    // Output: none
+    // Purpose: Compile the Trie into a flat automaton with failure and output links
+    AhoCorasick(Trie &trie)
+    {
+        // 1. Number the Trie nodes in BFS order and record their edges.
+        // 2. Compress the byte alphabet to the bytes that appear in patterns.
+        // 3. Fill goto transitions, then derive failure transitions level by level.
+        // 4. Link every state to the nearest terminal state on its failure chain.
+
+        vector<vector<pair<unsigned char, int>>> edges;
+        vector<TrieNode *> nodes;
+        vector<bool> usedByte(256, false);
+
+        nodes.push_back(trie.root);
+        for (size_t s = 0; s < nodes.size(); s++)
+        {
+            TrieNode *node = nodes[s];
+            edges.push_back({});
+
+            for (int i = 0; i < 26; i++)
+            {
+                if (node->children[i])
+                {
+                    edges[s].push_back({(unsigned char)('a' + i), (int)nodes.size()});
+                    nodes.push_back(node->children[i]);
+                }
+            }
+            for (auto &entry : node->mapchildren)
+            {
+                edges[s].push_back({(unsigned char)entry.first, (int)nodes.size()});
+                nodes.push_back(entry.second);
+            }
+            for (auto &edge : edges[s])
+            {
+                usedByte[edge.first] = true;
+            }
+        }
+
+        numClasses = 1;
+        for (int b = 0; b < 256; b++)
+        {
+            classOf[b] = usedByte[b] ? numClasses++ : 0;
+        }
+
+        int numStates = nodes.size();
+        next.assign((size_t)numStates * numClasses, -1);
+        patternOf.assign(numStates, -1);
+        outLink.assign(numStates, -1);
+        firstOut.assign(numStates, -1);
+        vector<int> fail(numStates, 0);
+
+        // Only the parent, edge byte and depth of each state are kept; a pattern's
+        // text is spelled backwards from its terminal state, so the build never
+        // holds the prefix string of every state
+        vector<int> parent(numStates, 0);
+        vector<unsigned char> label(numStates, 0);
+        vector<int> depth(numStates, 0);
+        for (int s = 0; s < numStates; s++)
+        {
+            for (auto &edge : edges[s])
+            {
+                next[(size_t)s * numClasses + classOf[edge.first]] = edge.second;
+                parent[edge.second] = s;
+                label[edge.second] = edge.first;
+                depth[edge.second] = depth[s] + 1;
+            }
+            if (s != 0 && nodes[s]->isEndOfWord)
+            {
+                string text(depth[s], '\0');
+                for (int t = s; t != 0; t = parent[t])
+                {
+                    text[depth[t] - 1] = (char)label[t];
+                }
+                patternOf[s] = patterns.size();
+                patterns.push_back(text);
+            }
+        }
+
+        // BFS order guarantees fail[s] is final before any child of s is processed
+        for (int s = 0; s < numStates; s++)
+        {
+            int *row = &next[(size_t)s * numClasses];
+            int *failRow = &next[(size_t)fail[s] * numClasses];
+
+            for (int cls = 0; cls < numClasses; cls++)
+            {
+                if (row[cls] == -1)
+                {
+                    row[cls] = (s == 0) ? 0 : failRow[cls];
+                }
+                else
+                {
+                    int child = row[cls];
+                    fail[child] = (s == 0) ? 0 : failRow[cls];
+                    outLink[child] = patternOf[fail[child]] != -1 ? fail[child] : outLink[fail[child]];
+                }
+            }
+
+            firstOut[s] = patternOf[s] != -1 ? s : outLink[s];
+        }
+    }
+
+    // Scan one chunk of a stream
+    // Input: buffer and its length, stream state to continue from, callback(patternId, startOffset)
+    // Output: none (callback is invoked once per match, startOffset is relative to the stream start)
+    // Purpose: Report every occurrence of every pattern in a single pass
+    template <typename Callback>
+    void scan(const char *buffer, size_t length, ScanState &scanState, Callback callback) const
+    {
+        int s = scanState.state;
+        const int *table = next.data();
+        const int *out = firstOut.data();
+
+        for (size_t i = 0; i < length; i++)
+        {
+            s = table[(size_t)s * numClasses + classOf[(unsigned char)buffer[i]]];
+
+            for (int o = out[s]; o != -1; o = outLink[o])
+            {
+                int id = patternOf[o];
+                callback(id, scanState.offset + i + 1 - patterns[id].size());
+            }
+        }
+
+        scanState.state = s;
+        scanState.offset += length;
+    }
+
+    // Scan a complete buffer
+    // Input: text to scan, callback(patternId, startOffset)
+    // Output: none
+    // Purpose: Convenience wrapper for a stream made of a single chunk
+    template <typename Callback>
+    void scan(const string &text, Callback callback) const
+    {
+        ScanState scanState;
+        scan(text.data(), text.size(), scanState, callback);
+    }
+
+    // Get the text of a pattern reported by scan
+    const string &pattern(int id) const
+    {
+        return patterns[id];
+    }
+
+    // Number of automaton states
+    int stateCount() const
+    {
+        return firstOut.size();
+    }
+};
+
+// Bit vector with rank and select support
+// Bits are appended with push and the directories are built once with build().
+// rank1 uses the count of ones before every 512-bit block (6.25% extra);
+// select0 starts from a sampled position of every 512th zero and scans forward.
+// Positions are limited to 2^32 bits by the directory entries.
+class BitVector
+{
+private:
+    static const size_t BLOCK_BITS = 512;
+    static const size_t ZERO_SAMPLE = 512;
+
+    vector<unsigned long long> bits;
+    size_t length;
+    // blockRank[b] = ones before block b; one extra entry holds the total
+    vector<unsigned int> blockRank;
+    // zeroSamples[s] = position of the (s * ZERO_SAMPLE)-th zero
+    vector<unsigned int> zeroSamples;
+
+    // Helper function to find the r-th set bit of a word
+    // Input: word, r (0-based, below the word's popcount)
+    // Output: bit position
+    static int selectInWord(unsigned long long word, size_t r)
+    {
+        for (size_t i = 0; i < r; i++)
+        {
+            word &= word - 1;
+        }
+        return __builtin_ctzll(word);
+    }
+
+public:
+    // Constructor
+    BitVector()
+    {
+        length = 0;
+    }
+
+    // Append one bit
+    void push(bool bit)
+    {
+        if (length % 64 == 0)
+            bits.push_back(0);
+        if (bit)
+            bits.back() |= 1ULL << (length % 64);
+        length++;
+    }
+
+    // Build the rank and select directories after the last push
+    void build()
+    {
+        size_t words = bits.size();
+        blockRank.assign((words + 7) / 8 + 1, 0);
+        zeroSamples.clear();
+
+        size_t ones = 0;
+        for (size_t w = 0; w < words; w++)
+        {
+            if (w % 8 == 0)
+                blockRank[w / 8] = ones;
+            ones += __builtin_popcountll(bits[w]);
+        }
+        blockRank.back() = ones;
+        bits.shrink_to_fit();
+
+        size_t zeros = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            if (!get(i))
+            {
+                if (zeros % ZERO_SAMPLE == 0)
+                    zeroSamples.push_back(i);
+                zeros++;
+            }
+        }
+    }
+
+    // Read one bit
+    bool get(size_t i) const
+    {
+        return (bits[i / 64] >> (i % 64)) & 1;
+    }
+
+    // Number of ones in [0, pos)
+    size_t rank1(size_t pos) const
+    {
+        size_t block = pos / BLOCK_BITS;
+        size_t rank = blockRank[block];
+
+        for (size_t w = block * 8; w < pos / 64; w++)
+        {
+            rank += __builtin_popcountll(bits[w]);
+        }
+        if (pos % 64)
+            rank += __builtin_popcountll(bits[pos / 64] & ((1ULL << (pos % 64)) - 1));
+
+        return rank;
+    }
+
+    // Position of the k-th zero (0-based); k must be below the number of zeros
+    size_t select0(size_t k) const
+    {
+        size_t block = zeroSamples[k / ZERO_SAMPLE] / BLOCK_BITS;
+        while (block + 1 < blockRank.size() && (block + 1) * BLOCK_BITS - blockRank[block + 1] <= k)
+            block++;
+
+        size_t remaining = k - (block * BLOCK_BITS - blockRank[block]);
+        for (size_t w = block * 8;; w++)
+        {
+            unsigned long long zeros = ~bits[w];
+            size_t count = __builtin_popcountll(zeros);
+            if (remaining < count)
+                return w * 64 + selectInWord(zeros, remaining);
+            remaining -= count;
+        }
+    }
+
+    // Position of the first zero at or after pos; there must be one
+    size_t nextZero(size_t pos) const
+    {
+        size_t w = pos / 64;
+        unsigned long long zeros = ~bits[w] & (~0ULL << (pos % 64));
+
+        while (!zeros)
+            zeros = ~bits[++w];
+
+        return w * 64 + __builtin_ctzll(zeros);
+    }
+
+    // Number of bits
+    size_t size() const
+    {
+        return length;
+    }
+
+    // Heap usage in bytes
+    size_t memoryBytes() const
+    {
+        return bits.capacity() * sizeof(unsigned long long) + blockRank.capacity() * sizeof(unsigned int) +
+               zeroSamples.capacity() * sizeof(unsigned int);
+    }
+};
+
+// Succinct read-only trie frozen from a Trie
+// Nodes are numbered in BFS order (root = 0) and the shape is stored as a LOUDS
+// bit string: for every node, one 1 per child followed by a 0, so 2 bits per
+// node. The k-th 1 is the edge into node k + 1, so the children of node v are
+// the consecutive ids starting at (select0(v - 1) + 1) - v + 1, and labels[v]
+// is the byte on the edge into v. A second bit vector marks terminal nodes;
+// its rank numbers the words, which index a varint-packed side array of
+// (insertFreq, searchFreq) pairs with a byte offset checkpoint every 64 words.
+// Altogether about 3.2 bits per node plus the 8-bit label and the frequencies.
+class LoudsTrie
+{
+private:
+    // Words between frequency checkpoints
+    static const size_t FREQ_CHECKPOINT = 64;
+
+    BitVector louds;
+    BitVector terminal;
+    vector<unsigned char> labels;
+    vector<unsigned char> frequencies;
+    vector<size_t> checkpoints;
+    size_t wordCount;
+
+    // Helper function to append a varint
+    // Input: value
+    // Output: none (appends 7 bits per byte, high bit set while more bytes follow)
+    void putVarint(unsigned int value)
+    {
+        while (value >= 0x80)
+        {
+            frequencies.push_back((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        frequencies.push_back(value);
+    }
+
+    // Helper function to read a varint
+    // Input: byte offset (advanced past the value)
+    // Output: value
+    unsigned int getVarint(size_t &offset) const
+    {
+        unsigned int value = 0;
+        int shift = 0;
+
+        while (frequencies[offset] & 0x80)
+        {
+            value |= (unsigned int)(frequencies[offset++] & 0x7f) << shift;
+            shift += 7;
+        }
+        value |= (unsigned int)frequencies[offset++] << shift;
+
+        return value;
+    }
+
+    // Helper function to get the frequencies of a terminal node
+    // Input: node id (must be terminal), outputs for insertFreq and searchFreq
+    // Output: none
+    // Purpose: Jump to the nearest checkpoint and decode forward
+    void frequenciesOf(size_t node, int &insertFreq, int &searchFreq) const
+    {
+        size_t word = terminal.rank1(node);
+        size_t offset = checkpoints[word / FREQ_CHECKPOINT];
+
+        for (size_t i = 0; i < word % FREQ_CHECKPOINT * 2; i++)
+        {
+            getVarint(offset);
+        }
+        insertFreq = getVarint(offset);
+        searchFreq = getVarint(offset);
+    }
+
+    // Helper function to get the children of a node
+    // Input: node id, outputs for the first child id and the number of children
+    // Output: none
+    void childRange(size_t node, size_t &first, size_t &count) const
+    {
+        size_t start = node == 0 ? 0 : louds.select0(node - 1) + 1;
+        size_t end = louds.nextZero(start);
+
+        first = start - node + 1;
+        count = end - start;
+    }
+
+    // Helper function to get the child of a node for a character
+    // Input: node id, character
+    // Output: the child's id, or -1 if there is none
+    // Purpose: Children are sorted by byte, so their labels can be binary searched
+    long long childOf(size_t node, char c) const
+    {
+        size_t first, count;
+        childRange(node, first, count);
+
+        auto begin = labels.begin() + first;
+        auto it = lower_bound(begin, begin + count, (unsigned char)c);
+        if (it == begin + count || *it != (unsigned char)c)
+            return -1;
+
+        return it - labels.begin();
+    }
+
+    // Helper function to find the node a key leads to
+    // Input: key
+    // Output: the node id, or -1 if no word has this prefix
+    long long findNode(const string &key) const
+    {
+        long long node = 0;
+
+        for (size_t i = 0; i < key.size() && node >= 0; i++)
+        {
+            node = childOf(node, key[i]);
+        }
+
+        return node;
+    }
+
+    // Helper function to collect all words below a node
+    // Input: node id, word formed so far, results vector of word-searchFreq pairs
+    // Output: none (modifies results vector by reference)
+    void collectWords(size_t node, string &word, vector<pair<string, int>> &results) const
+    {
+        if (terminal.get(node))
+        {
+            int insertFreq, searchFreq;
+            frequenciesOf(node, insertFreq, searchFreq);
+            results.push_back({word, searchFreq});
+        }
+
+        size_t first, count;
+        childRange(node, first, count);
+        for (size_t child = first; child < first + count; child++)
+        {
+            word.push_back(labels[child]);
+            collectWords(child, word, results);
+            word.pop_back();
+        }
+    }
+
+public:
+    // Constructor
+    // Input: populated Trie (not modified)
+    // Output: none
+    // Purpose: Freeze the Trie: BFS over its nodes with children in byte order,
+    //          writing the LOUDS bits, labels, terminal bits and frequencies
+    LoudsTrie(Trie &trie)
+    {
+        wordCount = 0;
+        labels.push_back(0);
+
+        queue<TrieNode *> pending;
+        pending.push(trie.root);
+        while (!pending.empty())
+        {
+            TrieNode *node = pending.front();
+            pending.pop();
+
+            terminal.push(node->isEndOfWord);
+            if (node->isEndOfWord)
+            {
+                if (wordCount % FREQ_CHECKPOINT == 0)
+                    checkpoints.push_back(frequencies.size());
+                putVarint(node->insertFreq);
+                putVarint(node->searchFreq);
+                wordCount++;
+            }
+
+            for (auto &entry : trie.orderedChildren(node))
+            {
+                louds.push(true);
+                labels.push_back(entry.first);
+                pending.push(entry.second);
+            }
+            louds.push(false);
+        }
+
+        louds.build();
+        terminal.build();
+        labels.shrink_to_fit();
+        frequencies.shrink_to_fit();
+        checkpoints.shrink_to_fit();
+    }
+
+    // Search for a word
+    // Input: word to search for (string)
+    // Output: boolean indicating if the word exists (read-only, so searchFreq is not updated)
+    bool search(const string &word) const
+    {
+        long long node = findNode(word);
+        return node >= 0 && terminal.get(node);
+    }
+
+    // Check if any word starts with the given prefix
+    // Input: prefix to check (string)
+    // Output: boolean indicating if any word has this prefix
+    bool startsWith(const string &prefix) const
+    {
+        return findNode(prefix) >= 0;
+    }
+
+    // Get the frequency of a word
+    // Input: word to check (string)
+    // Output: insertFreq recorded when the Trie was frozen, 0 if the word is absent
+    int getFrequency(const string &word) const
+    {
+        long long node = findNode(word);
+        if (node < 0 || !terminal.get(node))
+            return 0;
+
+        int insertFreq, searchFreq;
+        frequenciesOf(node, insertFreq, searchFreq);
+        return insertFreq;
+    }
+
+    // Count how many words start with the given prefix
+    // Input: prefix to check (string)
+    // Output: integer count of words with the prefix
+    // Purpose: The descendants of a node on each level form one range of BFS ids,
+    //          so count terminals level by level with rank instead of visiting them
+    int prefixCount(const string &prefix) const
+    {
+        long long node = findNode(prefix);
+        if (node < 0)
+            return 0;
+
+        size_t lo = node, hi = node + 1;
+        size_t count = 0;
+        while (lo < hi)
+        {
+            count += terminal.rank1(hi) - terminal.rank1(lo);
+
+            // Children of [lo, hi) are the 1s between the starts of lo's and hi's blocks
+            size_t start = lo == 0 ? 0 : louds.select0(lo - 1) + 1;
+            size_t end = louds.select0(hi - 1);
+            lo = start - lo + 1;
+            hi = end - (hi - 1) + 1;
+        }
+
+        return count;
+    }
+
+    // Get all words that start with the given prefix
+    // Input: prefix to complete (string, matched exactly)
+    // Output: vector of word-searchFreq pairs, sorted by frequency (highest first)
+    vector<pair<string, int>> autocomplete(const string &prefix) const
+    {
+        vector<pair<string, int>> suggestions;
+
+        long long node = findNode(prefix);
+        if (node < 0)
+            return suggestions;
+
+        string word = prefix;
+        collectWords(node, word, suggestions);
+        stable_sort(suggestions.begin(), suggestions.end(), Trie::cmp);
+
+        return suggestions;
+    }
+
+    // Find the longest prefix of the target that is a word
+    // Input: target string to match
+    // Output: the longest matching prefix (string)
+    string LongestPrefixMatch(const string &target) const
+    {
+        long long node = 0;
+        size_t longest = 0;
+
+        for (size_t i = 0; i < target.size(); i++)
+        {
+            node = childOf(node, target[i]);
+            if (node < 0)
+                break;
+
+            if (terminal.get(node))
+                longest = i + 1;
+        }
+
+        return target.substr(0, longest);
+    }
+
+    // Number of stored words
+    size_t size() const
+    {
+        return wordCount;
+    }
+
+    // Number of nodes, including the root
+    size_t nodeCount() const
+    {
+        return terminal.size();
+    }
+
+    // Heap usage in bytes
+    size_t memoryBytes() const
+    {
+        return louds.memoryBytes() + terminal.memoryBytes() + labels.capacity() + frequencies.capacity() +
+               checkpoints.capacity() * sizeof(size_t);
+    }
+};
+
+// Double-array trie compiled from a Trie
+// Every state s has base[s]; the transition on byte b goes to t = base[s] + b + 1
+// and exists only if check[t] == s. The arrays always extend 256 slots past the
+// largest base, so a transition is two array reads with no bounds test, no hash
+// and no split between lowercase and other bytes. child[s] and sibling[t] keep
+// each state's child codes as a sorted list so words can be enumerated and
+// states relocated without trying all 256 codes. Free slots have a negative
+// check and sit on a doubly linked free list, so placing a state only looks at
+// free slots; a slot that keeps failing as a base candidate is dropped from the
+// list (it stays free and can still be claimed by a state that fits around it).
+class DoubleArrayTrie
+{
+private:
+    // Codes are byte + 1, so code 0 can mean "none" in child and sibling
+    static const int CODES = 257;
+    // check values of free slots: on the free list, or dropped from it
+    static const int FREE = -1;
+    static const int DROPPED = -2;
+    // Failed base attempts after which a free slot leaves the free list
+    static const int MAX_TRIALS = 16;
+
+    vector<int> base;
+    vector<int> check;
+    // First child code of a state and next sibling code of a state, 0 if none
+    vector<unsigned short> child;
+    vector<unsigned short> sibling;
+    // Word id of a terminal state, -1 otherwise
+    vector<int> wordOf;
+    // Number of words at or below each state, so prefixCount needs no subtree walk
+    vector<int> wordCounts;
+    vector<int> insertFreqs;
+    vector<int> searchFreqs;
+    // Free list links (-1 at the ends) and failed base attempts per free slot
+    vector<int> nextFree;
+    vector<int> prevFree;
+    vector<unsigned char> trials;
+    int freeHead;
+    int freeTail;
+
+    // Helper function to put a free slot on the free list
+    // Input: slot
+    // Output: none
+    // Purpose: Freed slots go to the front, so they are tried first
+    void linkFree(int i)
+    {
+        check[i] = FREE;
+        trials[i] = 0;
+        prevFree[i] = -1;
+        nextFree[i] = freeHead;
+
+        if (freeHead >= 0)
+            prevFree[freeHead] = i;
+        else
+            freeTail = i;
+        freeHead = i;
+    }
+
+    // Helper function to take a slot off the free list
+    // Input: slot (check must be FREE)
+    // Output: none
+    void unlinkFree(int i)
+    {
+        if (prevFree[i] >= 0)
+            nextFree[prevFree[i]] = nextFree[i];
+        else
+            freeHead = nextFree[i];
+
+        if (nextFree[i] >= 0)
+            prevFree[nextFree[i]] = prevFree[i];
+        else
+            freeTail = prevFree[i];
+    }
+
+    // Helper function to make room for a base
+    // Input: base value about to be used
+    // Output: none
+    // Purpose: Keep every base + 256 inside the arrays, so lookups need no bounds test
+    void reserveFor(int b)
+    {
+        size_t needed = (size_t)b + CODES;
+        if (needed <= check.size())
+            return;
+
+        size_t old = check.size();
+        size_t grown = max(needed, old * 3 / 2);
+        base.resize(grown, 0);
+        check.resize(grown, (int)FREE);
+        child.resize(grown, 0);
+        sibling.resize(grown, 0);
+        wordOf.resize(grown, -1);
+        wordCounts.resize(grown, 0);
+        nextFree.resize(grown, -1);
+        prevFree.resize(grown, -1);
+        trials.resize(grown, 0);
+
+        // New slots join the back of the free list in order
+        for (size_t i = old; i < grown; i++)
+        {
+            prevFree[i] = freeTail;
+            if (freeTail >= 0)
+                nextFree[freeTail] = i;
+            else
+                freeHead = i;
+            freeTail = i;
+        }
+    }
+
+    // Helper function to find a base where all given codes land on free slots
+    // Input: sorted child codes (non-empty)
+    // Output: base value
+    // Purpose: Try the free slots in list order as the home of the first code
+    int findBase(const vector<int> &codes)
+    {
+        if (freeHead < 0)
+            reserveFor(check.size());
+
+        for (int pos = freeHead;;)
+        {
+            int b = pos - codes[0];
+            if (b >= 1)
+            {
+                reserveFor(b);
+
+                bool fits = true;
+                for (size_t i = 1; i < codes.size() && fits; i++)
+                {
+                    fits = check[b + codes[i]] < 0;
+                }
+                if (fits)
+                    return b;
+            }
+
+            int next = nextFree[pos];
+            if (++trials[pos] >= MAX_TRIALS)
+            {
+                unlinkFree(pos);
+                check[pos] = DROPPED;
+            }
+
+            // Out of candidates: grow and continue with the new slots
+            if (next < 0)
+            {
+                next = check.size();
+                reserveFor(next);
+            }
+            pos = next;
+        }
+    }
+
+    // Helper function to list the child codes of a state
+    // Input: state
+    // Output: child codes in increasing order
+    vector<int> childCodes(int s)
+    {
+        vector<int> codes;
+
+        for (int c = child[s]; c; c = sibling[base[s] + c])
+        {
+            codes.push_back(c);
+        }
+
+        return codes;
+    }
+
+    // Helper function to create the child of a state for a code
+    // Input: state, code (the slot base[s] + code must be free)
+    // Output: the new state
+    // Purpose: Claim the slot and link it into the parent's sorted child list
+    int attach(int s, int code)
+    {
+        int t = base[s] + code;
+        if (check[t] == FREE)
+            unlinkFree(t);
+        check[t] = s;
+        base[t] = 0;
+        child[t] = 0;
+        wordOf[t] = -1;
+        wordCounts[t] = 0;
+
+        if (!child[s] || code < child[s])
+        {
+            sibling[t] = child[s];
+            child[s] = code;
+        }
+        else
+        {
+            int prev = child[s];
+            while (sibling[base[s] + prev] && sibling[base[s] + prev] < code)
+                prev = sibling[base[s] + prev];
+            sibling[t] = sibling[base[s] + prev];
+            sibling[base[s] + prev] = code;
+        }
+
+        return t;
+    }
+
+    // Helper function to move the children of a state to a new base
+    // Input: state, extra code the new base must also have room for
+    // Output: none
+    // Purpose: Resolve a collision on insert; grandchildren are re-pointed at the moved states
+    void relocate(int s, int extraCode)
+    {
+        vector<int> codes = childCodes(s);
+        vector<int> wanted = codes;
+        wanted.insert(lower_bound(wanted.begin(), wanted.end(), extraCode), extraCode);
+
+        int newBase = findBase(wanted);
+        int oldBase = base[s];
+
+        for (int code : codes)
+        {
+            int from = oldBase + code;
+            int to = newBase + code;
+
+            if (check[to] == FREE)
+                unlinkFree(to);
+            base[to] = base[from];
+            check[to] = s;
+            child[to] = child[from];
+            sibling[to] = sibling[from];
+            wordOf[to] = wordOf[from];
+            wordCounts[to] = wordCounts[from];
+
+            for (int c = child[from]; c; c = sibling[base[from] + c])
+            {
+                check[base[from] + c] = to;
+            }
+
+            linkFree(from);
+        }
+
+        base[s] = newBase;
+    }
+
+    // Helper function to find the state a key leads to
+    // Input: key
+    // Output: the state, or -1 if no word has this prefix
+    int findState(const string &key) const
+    {
+        int s = 0;
+
+        for (char c : key)
+        {
+            int t = base[s] + (unsigned char)c + 1;
+            if (check[t] != s)
+                return -1;
+            s = t;
+        }
+
+        return s;
+    }
+
+    // Helper function to collect all words below a state
+    // Input: state, word formed so far, results vector of word-searchFreq pairs
+    // Output: none (modifies results vector by reference)
+    void collectWords(int s, string &word, vector<pair<string, int>> &results) const
+    {
+        if (wordOf[s] >= 0)
+            results.push_back({word, searchFreqs[wordOf[s]]});
+
+        for (int c = child[s]; c; c = sibling[base[s] + c])
+        {
+            word.push_back((char)(c - 1));
+            collectWords(base[s] + c, word, results);
+            word.pop_back();
+        }
+    }
+
+public:
+    // Constructor
+    // Input: populated Trie (not modified)
+    // Output: none
+    // Purpose: Compile the Trie state by state in BFS order, placing each
+    //          state's children at the first base where they all fit
+    DoubleArrayTrie(Trie &trie)
+    {
+        freeHead = -1;
+        freeTail = -1;
+        reserveFor(0);
+        unlinkFree(0);
+        check[0] = 0;
+
+        queue<pair<TrieNode *, int>> pending;
+        pending.push({trie.root, 0});
+        while (!pending.empty())
+        {
+            TrieNode *node = pending.front().first;
+            int s = pending.front().second;
+            pending.pop();
+            wordCounts[s] = node->wordCount;
+
+            if (node->isEndOfWord)
+            {
+                wordOf[s] = insertFreqs.size();
+                insertFreqs.push_back(node->insertFreq);
+                searchFreqs.push_back(node->searchFreq);
+            }
+
+            vector<pair<char, TrieNode *>> children = trie.orderedChildren(node);
+            if (children.empty())
+                continue;
+
+            vector<int> codes;
+            for (auto &entry : children)
+            {
+                codes.push_back((unsigned char)entry.first + 1);
+            }
+            base[s] = findBase(codes);
+
+            for (size_t i = 0; i < children.size(); i++)
+            {
+                pending.push({children[i].second, attach(s, codes[i])});
+            }
+        }
+    }
+
+    // Insert a word
+    // Input: word to insert (string)
+    // Output: true if the word is new, false if it was already stored (its insertFreq is bumped)
+    // Purpose: Follow existing transitions, then add states; when a slot is taken,
+    //          relocate the parent's children to a base with room for the new code
+    bool insert(const string &word)
+    {
+        int s = 0;
+
+        for (char c : word)
+        {
+            int code = (unsigned char)c + 1;
+            int t = base[s] + code;
+
+            if (check[t] == s)
+            {
+                s = t;
+                continue;
+            }
+
+            if (!child[s])
+            {
+                // A leaf gets its own base, so it never shares the slots of unrelated states
+                base[s] = findBase({code});
+            }
+            else if (check[t] >= 0)
+            {
+                relocate(s, code);
+            }
+            s = attach(s, code);
+        }
+
+        if (wordOf[s] >= 0)
+        {
+            insertFreqs[wordOf[s]]++;
+            return false;
+        }
+
+        wordOf[s] = insertFreqs.size();
+        insertFreqs.push_back(1);
+        searchFreqs.push_back(0);
+
+        // Relocations only move states below the path, so a second walk finds every state on it
+        s = 0;
+        wordCounts[0]++;
+        for (char c : word)
+        {
+            s = base[s] + (unsigned char)c + 1;
+            wordCounts[s]++;
+        }
+        return true;
+    }
+
+    // Search for a word
+    // Input: word to search for (string)
+    // Output: boolean indicating if the word exists
+    // Purpose: Two array reads per character; bumps searchFreq like Trie::search
+    bool search(const string &word)
+    {
+        int s = findState(word);
+        if (s < 0 || wordOf[s] < 0)
+            return false;
+
+        searchFreqs[wordOf[s]]++;
+        return true;
+    }
+
+    // Check if any word starts with the given prefix
+    // Input: prefix to check (string)
+    // Output: boolean indicating if any word has this prefix
+    bool startsWith(const string &prefix) const
+    {
+        return findState(prefix) >= 0;
+    }
+
+    // Get the frequency of a word
+    // Input: word to check (string)
+    // Output: how many times the word has been inserted, 0 if it is absent
+    int getFrequency(const string &word) const
+    {
+        int s = findState(word);
+        return s >= 0 && wordOf[s] >= 0 ? insertFreqs[wordOf[s]] : 0;
+    }
+
+    // Count how many words start with the given prefix
+    // Input: prefix to check (string)
+    // Output: integer count of words with the prefix
+    // Purpose: O(|prefix|), the count is stored per state
+    int prefixCount(const string &prefix) const
+    {
+        int s = findState(prefix);
+        return s >= 0 ? wordCounts[s] : 0;
+    }
+
+    // Get all words that start with the given prefix
+    // Input: prefix to complete (string, matched exactly)
+    // Output: vector of word-searchFreq pairs, sorted by frequency (highest first)
+    vector<pair<string, int>> autocomplete(const string &prefix) const
+    {
+        vector<pair<string, int>> suggestions;
+
+        int s = findState(prefix);
+        if (s < 0)
+            return suggestions;
+
+        string word = prefix;
+        collectWords(s, word, suggestions);
+        stable_sort(suggestions.begin(), suggestions.end(), Trie::cmp);
+
+        return suggestions;
+    }
+
+    // Find the longest prefix of the target that is a word
+    // Input: target string to match
+    // Output: the longest matching prefix (string)
+    string LongestPrefixMatch(const string &target) const
+    {
+        int s = 0;
+        size_t longest = 0;
+
+        for (size_t i = 0; i < target.size(); i++)
+        {
+            int t = base[s] + (unsigned char)target[i] + 1;
+            if (check[t] != s)
+                break;
+
+            s = t;
+            if (wordOf[s] >= 0)
+                longest = i + 1;
+        }
+
+        return target.substr(0, longest);
+    }
+
+    // Number of stored words
+    size_t size() const
+    {
+        return insertFreqs.size();
+    }
+
+    // Share of array slots in use
+    double occupancy() const
+    {
+        size_t used = 0;
+        for (int owner : check)
+        {
+            used += owner >= 0;
+        }
+        return (double)used / check.size();
+    }
+
+    // Heap usage in bytes
+    size_t memoryBytes() const
+    {
+        return check.capacity() * (6 * sizeof(int) + 2 * sizeof(unsigned short) + sizeof(unsigned char)) +
+               (insertFreqs.capacity() + searchFreqs.capacity()) * sizeof(int);
+    }
+};
+
+#endif // TRIE_H
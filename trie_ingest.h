@@ -0,0 +1,331 @@
+#ifndef TRIE_INGEST_H
+#define TRIE_INGEST_H
+
+#include "trie.h"
+
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Splits raw corpus bytes into words
+// A chunk of input may only be cut right after a boundary character, so a
+// tokenizer must never produce a word that spans one. Tokenizers whose
+// boundaries depend on context (quoted fields) override chunkEnd as well.
+class Tokenizer
+{
+public:
+    virtual ~Tokenizer() {}
+
+    // Whether the input may be split right after this character
+    virtual bool isBoundary(char c) const = 0;
+
+    // Where to cut a chunk
+    // Input: start of the chunk (itself a cut), preferred end, end of the input
+    // Output: the first position at or after the preferred end that follows a boundary, or the end of the input
+    virtual const char *chunkEnd(const char *, const char *target, const char *end) const
+    {
+        while (target < end && !isBoundary(target[-1]))
+            target++;
+        return target;
+    }
+
+    // Call emit(word, length) for every word in [begin, end)
+    virtual void tokenize(const char *begin, const char *end, const function<void(const char *, size_t)> &emit) const = 0;
+};
+
+// Words are runs of non-whitespace characters
+class WhitespaceTokenizer : public Tokenizer
+{
+public:
+    bool isBoundary(char c) const override
+    {
+        return isspace((unsigned char)c);
+    }
+
+    void tokenize(const char *begin, const char *end, const function<void(const char *, size_t)> &emit) const override
+    {
+        const char *p = begin;
+        while (p < end)
+        {
+            while (p < end && isspace((unsigned char)*p))
+                p++;
+            const char *start = p;
+            while (p < end && !isspace((unsigned char)*p))
+                p++;
+            if (p > start)
+                emit(start, p - start);
+        }
+    }
+};
+
+// Every non-empty line is one word
+class LineTokenizer : public Tokenizer
+{
+public:
+    bool isBoundary(char c) const override
+    {
+        return c == '\n';
+    }
+
+    void tokenize(const char *begin, const char *end, const function<void(const char *, size_t)> &emit) const override
+    {
+        const char *p = begin;
+        while (p < end)
+        {
+            const char *start = p;
+            while (p < end && *p != '\n')
+                p++;
+            const char *stop = p;
+            if (stop > start && stop[-1] == '\r')
+                stop--;
+            if (stop > start)
+                emit(start, stop - start);
+            p++;
+        }
+    }
+};
+
+// One column of a delimited file is the word; double-quoted fields may contain the delimiter
+// and newlines, so records (and chunks) only end at a newline outside quotes
+class CsvColumnTokenizer : public Tokenizer
+{
+private:
+    int column;
+    char delimiter;
+
+public:
+    // Constructor
+    // Input: 0-based column index, field delimiter
+    CsvColumnTokenizer(int columnIndex, char fieldDelimiter = ',')
+    {
+        column = columnIndex;
+        delimiter = fieldDelimiter;
+    }
+
+    bool isBoundary(char c) const override
+    {
+        return c == '\n';
+    }
+
+    // A newline inside quotes does not end a record. The quote state at the preferred end
+    // is found by counting the quotes from the chunk start, which is a record boundary.
+    // An unbalanced quote makes the rest of the input one chunk.
+    const char *chunkEnd(const char *chunkStart, const char *target, const char *end) const override
+    {
+        bool quoted = false;
+        const char *p = chunkStart;
+        while ((p = (const char *)memchr(p, '"', target - 1 - p)) != nullptr)
+        {
+            quoted = !quoted;
+            p++;
+        }
+
+        for (p = target - 1; p < end; p++)
+        {
+            if (*p == '"')
+                quoted = !quoted;
+            else if (*p == '\n' && !quoted)
+                return p + 1;
+        }
+        return end;
+    }
+
+    void tokenize(const char *begin, const char *end, const function<void(const char *, size_t)> &emit) const override
+    {
+        const char *p = begin;
+        while (p < end)
+        {
+            int field = 0;
+            bool quoted = false;
+            const char *start = p;
+
+            while (p < end && (*p != '\n' || quoted))
+            {
+                if (*p == '"')
+                {
+                    quoted = !quoted;
+                }
+                else if (*p == delimiter && !quoted)
+                {
+                    if (field == column)
+                        break;
+                    field++;
+                    start = p + 1;
+                }
+                p++;
+            }
+
+            if (field == column)
+            {
+                const char *stop = p;
+                if (stop > start && stop[-1] == '\r')
+                    stop--;
+                if (stop - start >= 2 && *start == '"' && stop[-1] == '"')
+                {
+                    start++;
+                    stop--;
+                }
+                if (stop > start)
+                    emit(start, stop - start);
+            }
+
+            // Skip the rest of the record
+            while (p < end && (*p != '\n' || quoted))
+            {
+                if (*p == '"')
+                    quoted = !quoted;
+                p++;
+            }
+            p++;
+        }
+    }
+};
+
+// Totals of one ingestion run
+struct IngestStats
+{
+    size_t bytes = 0;
+    size_t words = 0;
+    double seconds = 0;
+};
+
+// Parallel corpus loader
+// Input files are memory-mapped and cut into chunks at tokenizer boundaries.
+// Worker threads take chunks from a shared counter and insert their words into
+// a private Trie each, so repeated words only bump insertFreq locally. The
+// private tries are then merged into the target Trie, which sums insertFreq,
+// and the target's side indexes are rebuilt once at the end.
+class CorpusIngestor
+{
+private:
+    // A memory-mapped input file
+    struct MappedFile
+    {
+        const char *data;
+        size_t size;
+    };
+
+    // A piece of a mapped file that starts and ends on a boundary
+    struct Chunk
+    {
+        const char *begin;
+        const char *end;
+    };
+
+public:
+    // Load words from files into a Trie
+    // Input: target Trie, input paths, tokenizer, number of threads, target chunk size in bytes
+    // Output: totals (files that cannot be opened are skipped)
+    // Purpose: Fill the Trie from a large corpus using all cores
+    static IngestStats ingest(Trie &trie, const vector<string> &paths, const Tokenizer &tokenizer,
+                              int threadCount = 0, size_t chunkBytes = 32 << 20)
+    {
+        // 1. Map every file and cut it into chunks at word boundaries.
+        // 2. Tokenize chunks in parallel into per-thread tries.
+        // 3. Merge the per-thread tries into the target.
+        // 4. Unmap the files.
+
+        auto startTime = chrono::steady_clock::now();
+        IngestStats stats;
+
+        if (threadCount <= 0)
+            threadCount = max(1u, thread::hardware_concurrency());
+        chunkBytes = max<size_t>(chunkBytes, 4096);
+
+        vector<MappedFile> files;
+        vector<Chunk> chunks;
+        for (const string &path : paths)
+        {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                continue;
+
+            struct stat info;
+            if (fstat(fd, &info) < 0 || info.st_size == 0)
+            {
+                close(fd);
+                continue;
+            }
+
+            void *mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (mapped == MAP_FAILED)
+                continue;
+            madvise(mapped, info.st_size, MADV_SEQUENTIAL);
+
+            MappedFile file = {(const char *)mapped, (size_t)info.st_size};
+            files.push_back(file);
+            stats.bytes += file.size;
+
+            const char *start = file.data;
+            const char *fileEnd = file.data + file.size;
+            while (start < fileEnd)
+            {
+                const char *end = start + min<size_t>(fileEnd - start, chunkBytes);
+                end = tokenizer.chunkEnd(start, end, fileEnd);
+                chunks.push_back({start, end});
+                start = end;
+            }
+        }
+
+        vector<unique_ptr<Trie>> locals;
+        vector<size_t> wordCounts(threadCount, 0);
+        atomic<size_t> nextChunk(0);
+        vector<thread> workers;
+
+        for (int t = 0; t < threadCount; t++)
+        {
+            locals.emplace_back(new Trie());
+        }
+        for (int t = 0; t < threadCount; t++)
+        {
+            workers.emplace_back([&, t]()
+                                 {
+                                     Trie &local = *locals[t];
+                                     string word;
+                                     // Counted locally: the workers' slots of wordCounts share cache lines
+                                     size_t words = 0;
+                                     auto emit = [&](const char *text, size_t length)
+                                     {
+                                         word.assign(text, length);
+                                         local.insert(word);
+                                         words++;
+                                     };
+
+                                     for (size_t i = nextChunk++; i < chunks.size(); i = nextChunk++)
+                                     {
+                                         tokenizer.tokenize(chunks[i].begin, chunks[i].end, emit);
+                                     }
+                                     wordCounts[t] = words; });
+        }
+        for (thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        // The indexes and the memory budget are restored once, not after every merge
+        for (int t = 0; t < threadCount; t++)
+        {
+            trie.mergeFrom(*locals[t]);
+            stats.words += wordCounts[t];
+        }
+        trie.afterBulkChange();
+
+        for (MappedFile &file : files)
+        {
+            munmap((void *)file.data, file.size);
+        }
+
+        stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+        return stats;
+    }
+};
+
+#endif // TRIE_INGEST_H
@@ -0,0 +1,238 @@
+#ifndef TRIE_STATIC_H
+#define TRIE_STATIC_H
+
+#include <cstddef>
+#include <string_view>
+
+using namespace std;
+
+// Helper function to sort keywords at compile time
+// Input: keyword array, number of keywords
+// Output: none (sorts the array in place)
+// Purpose: std::sort is not constexpr in C++17; keyword sets are small, so insertion sort will do
+constexpr void sortKeywords(string_view *keys, size_t count)
+{
+    for (size_t i = 1; i < count; i++)
+    {
+        string_view key = keys[i];
+        size_t j = i;
+        while (j > 0 && key < keys[j - 1])
+        {
+            keys[j] = keys[j - 1];
+            j--;
+        }
+        keys[j] = key;
+    }
+}
+
+// Helper function to get the length of the common prefix of two keywords
+// Input: two keywords
+// Output: number of leading characters they share
+constexpr size_t commonPrefix(string_view a, string_view b)
+{
+    size_t length = 0;
+    while (length < a.size() && length < b.size() && a[length] == b[length])
+        length++;
+    return length;
+}
+
+// Count the nodes a StaticTrie needs for a keyword list
+// Input: keyword array
+// Output: number of distinct prefixes, including the empty one (the root)
+// Purpose: Size the StaticTrie template argument at compile time
+template <size_t K>
+constexpr size_t staticTrieNodes(const string_view (&keywords)[K])
+{
+    string_view sorted[K] = {};
+    for (size_t i = 0; i < K; i++)
+    {
+        sorted[i] = keywords[i];
+    }
+    sortKeywords(sorted, K);
+
+    // Each keyword adds the characters it does not share with the one before it
+    size_t nodes = 1;
+    for (size_t i = 0; i < K; i++)
+    {
+        nodes += sorted[i].size() - (i > 0 ? commonPrefix(sorted[i], sorted[i - 1]) : 0);
+    }
+    return nodes;
+}
+
+// Read-only trie for keyword sets known at build time
+// The nodes are numbered in BFS order, so the children of a node are
+// contiguous and sorted by label: a node is only (label, first child, child
+// count, terminal flag) in four flat arrays, plus a direct byte index for the
+// root's children. A constexpr instance is built by the compiler and lives in
+// read-only data, with no heap and no startup cost:
+//
+//     constexpr string_view verbs[] = {"GET", "HEAD", "POST"};
+//     constexpr StaticTrie<staticTrieNodes(verbs)> verbTrie(verbs);
+//     static_assert(verbTrie.search("HEAD"));
+template <size_t N>
+class StaticTrie
+{
+private:
+    // labels[i] is the character on the edge into node i (unused for the root, node 0)
+    char labels[N] = {};
+    int firstChild[N] = {};
+    unsigned short childCount[N] = {};
+    bool terminal[N] = {};
+    // The root usually has the most children, so its child for every byte is stored directly (0 if none)
+    int rootChild[256] = {};
+
+    // Helper function to get the child of a node for a character
+    // Input: node index, character
+    // Output: the child's index, or -1 if there is none
+    constexpr int childOf(int node, char c) const
+    {
+        if (node == 0)
+            return rootChild[(unsigned char)c] ? rootChild[(unsigned char)c] : -1;
+
+        int end = firstChild[node] + childCount[node];
+        for (int i = firstChild[node]; i < end; i++)
+        {
+            if (labels[i] == c)
+                return i;
+        }
+        return -1;
+    }
+
+    // Helper function to find the node a key leads to
+    // Input: key
+    // Output: the node index, or -1 if no keyword has this prefix
+    constexpr int findNode(string_view key) const
+    {
+        int node = 0;
+        for (size_t i = 0; i < key.size() && node >= 0; i++)
+        {
+            node = childOf(node, key[i]);
+        }
+        return node;
+    }
+
+public:
+    // Constructor
+    // Input: keyword array (duplicates are allowed); N must be staticTrieNodes(keywords)
+    // Output: none
+    // Purpose: Build the BFS-ordered node table, one level at a time
+    template <size_t K>
+    constexpr StaticTrie(const string_view (&keywords)[K])
+    {
+        // 1. Sort the keywords, so the prefixes of each length come out grouped by parent.
+        // 2. For every depth, walk the sorted keywords and give each new prefix the next index.
+        // 3. The parent index advances whenever the shorter prefix changes.
+
+        string_view sorted[K] = {};
+        size_t longest = 0;
+        for (size_t i = 0; i < K; i++)
+        {
+            sorted[i] = keywords[i];
+            longest = sorted[i].size() > longest ? sorted[i].size() : longest;
+        }
+        sortKeywords(sorted, K);
+
+        int nextIndex = 1;
+        int levelStart = 0;
+        for (size_t depth = 1; depth <= longest; depth++)
+        {
+            int parent = levelStart - 1;
+            int nodeIndex = -1;
+            int levelEnd = nextIndex;
+            string_view lastParent = "";
+            string_view lastPrefix = "";
+            bool first = true;
+
+            for (size_t i = 0; i < K; i++)
+            {
+                if (sorted[i].size() < depth - 1)
+                    continue;
+
+                // Every (depth - 1)-long prefix is a node of the previous level, in sorted order
+                string_view parentPrefix = sorted[i].substr(0, depth - 1);
+                bool newParent = first || parentPrefix != lastParent;
+                if (newParent)
+                {
+                    parent++;
+                    lastParent = parentPrefix;
+                    firstChild[parent] = nextIndex;
+                }
+                first = false;
+
+                if (sorted[i].size() < depth)
+                    continue;
+
+                string_view prefix = sorted[i].substr(0, depth);
+                if (newParent || prefix != lastPrefix)
+                {
+                    nodeIndex = nextIndex++;
+                    labels[nodeIndex] = prefix[depth - 1];
+                    childCount[parent]++;
+                    lastPrefix = prefix;
+                }
+                if (sorted[i].size() == depth)
+                    terminal[nodeIndex] = true;
+            }
+
+            levelStart = levelEnd;
+        }
+
+        for (int i = firstChild[0]; i < firstChild[0] + childCount[0]; i++)
+        {
+            rootChild[(unsigned char)labels[i]] = i;
+        }
+
+        // Keywords of length 0 make the root a word
+        for (size_t i = 0; i < K; i++)
+        {
+            if (sorted[i].empty())
+                terminal[0] = true;
+        }
+    }
+
+    // Search for a keyword
+    // Input: word to look up
+    // Output: boolean indicating if the word is one of the keywords
+    constexpr bool search(string_view word) const
+    {
+        int node = findNode(word);
+        return node >= 0 && terminal[node];
+    }
+
+    // Check if any keyword starts with the given prefix
+    // Input: prefix to check
+    // Output: boolean indicating if any keyword has this prefix
+    constexpr bool startsWith(string_view prefix) const
+    {
+        return findNode(prefix) >= 0;
+    }
+
+    // Find the longest prefix of the target that is a keyword
+    // Input: target string to match
+    // Output: the longest matching prefix, as a view into target (empty if there is none)
+    constexpr string_view LongestPrefixMatch(string_view target) const
+    {
+        int node = 0;
+        size_t longest = 0;
+
+        for (size_t i = 0; i < target.size(); i++)
+        {
+            node = childOf(node, target[i]);
+            if (node < 0)
+                break;
+
+            if (terminal[node])
+                longest = i + 1;
+        }
+
+        return target.substr(0, longest);
+    }
+
+    // Number of nodes in the table, including the root
+    constexpr size_t nodeCount() const
+    {
+        return N;
+    }
+};
+
+#endif // TRIE_STATIC_H